@@ -1,60 +1,428 @@
+#include <assert.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <limits.h>
+#include <string.h>
 #include <time.h>
 
+// Compilar com -DARVORE_ARENA (e ../ListaEx1/tadArena.c) faz os nós virem
+// de uma arena única; liberar_arvore devolve à arena só os nós da árvore
+// dada e liberar_todas_arvores devolve a arena inteira
+#ifdef ARVORE_ARENA
+#include "../ListaEx1/arena.h"
+#endif
+
+// Compilar com -DARVORE_INDICES (junto de -DARVORE_ARENA) liga os filhos
+// pelo índice de 32 bits do nó na arena (0 é "nenhum") em vez de um
+// ponteiro de 64 bits: NO() lê um filho e LIG() grava; sem a flag os dois
+// não fazem nada
+#ifdef ARVORE_INDICES
+#ifndef ARVORE_ARENA
+#error "ARVORE_INDICES precisa de ARVORE_ARENA (os índices são da arena)"
+#endif
+typedef unsigned int lig_t;
+#define NO(l) ((no_t *)itemArena(&arena_nos, (l)))
+#define LIG(p) indiceArena(&arena_nos, (p))
+#else
+typedef struct no *lig_t;
+#define NO(l) (l)
+#define LIG(p) (p)
+#endif
+
+// Compilar com -DARVORE_PARALELA -pthread acrescenta versões paralelas
+// (fork/join com roubo de tarefas) de somaChave, paiMaior e dobraArvore
+#ifdef ARVORE_PARALELA
+#ifdef ARVORE_ARENA
+#error "ARVORE_PARALELA usa malloc em várias threads; não combina com ARVORE_ARENA"
+#endif
+#include <pthread.h>
+#include <sched.h>
+#include <stdatomic.h>
+#include <unistd.h>
+#endif
+
+// Compilar com -DARVORE_AUMENTADA faz cada nó guardar também tamanho,
+// soma, mínimo e máximo da sua subárvore, mantidos por inserir() (o nó
+// passa de 24 para 48 bytes); as consultas que usam esses campos só valem
+// enquanto a árvore é de busca (antes de paiMaior, dobraArvore etc.)
+// As versões paralelas cortam a recursão pelo tamanho, então ligam a flag
+#if defined(ARVORE_PARALELA) && !defined(ARVORE_AUMENTADA)
+#define ARVORE_AUMENTADA
+#endif
+
+// Compilar com -DARVORE_AVL faz inserir() rebalancear a árvore (AVL),
+// evitando que entradas ordenadas a transformem em uma lista
 typedef struct no {
     int chave;
-    struct no *esq;
-    struct no *dir;
+    lig_t esq;
+    lig_t dir;
+#ifdef ARVORE_AUMENTADA
+    int tamanho;    // nós na subárvore
+    long long soma; // soma das chaves da subárvore
+    int minimo;     // menor e maior chave da subárvore
+    int maximo;
+#endif
+#ifdef ARVORE_AVL
+    int altura; // altura da subárvore com raiz neste nó
+#endif
 } no_t;
 
-typedef struct pilha {
-    no_t *no;
-    struct pilha *prox;
-} pilha_t;
+//Pilha de nós em um vetor que dobra de tamanho, usada pelos percursos
+//iterativos (a recursão estoura a pilha em árvores degeneradas grandes)
+typedef struct pilha_vetor {
+    no_t **nos;
+    int topo;
+    int cap;
+} pilha_vetor_t;
+
+//Árvore de busca congelada no layout de Eytzinger (ordem de BFS): os
+//filhos de chaves[k] ficam em chaves[2k] e chaves[2k+1] (a partir de
+//k = 1), sem ponteiros; serve para muitas buscas depois da construção
+typedef struct arvore_eytzinger {
+    int *chaves;
+    int n;
+} arvore_eytzinger_t;
 
 int aleat(int min, int max) {
   return (rand() % (max - min + 1)) + min;
 }
 
+#ifdef ARVORE_ARENA
+Arena arena_nos;
+int arena_criada = 0;
+#endif
+
+//Memória para um nó (campos não inicializados)
+no_t *novo_no() {
+#ifdef ARVORE_ARENA
+    if (!arena_criada) {
+        criaArena(&arena_nos, sizeof(no_t));
+        arena_criada = 1;
+    }
+    return (no_t *)alocaArena(&arena_nos);
+#else
+    return (no_t *)malloc(sizeof(no_t));
+#endif
+}
+
 //Cria um novo nó e retorna o ponteiro para ele
 no_t *criar_no(int chave) {
-    no_t *novo = (no_t *)malloc(sizeof(no_t));
+    no_t *novo = novo_no();
     if (novo) {
         novo->chave = chave;
-        novo->esq = novo->dir = NULL;
+        novo->esq = novo->dir = LIG(NULL);
+#ifdef ARVORE_AUMENTADA
+        novo->tamanho = 1;
+        novo->soma = chave;
+        novo->minimo = novo->maximo = chave;
+#endif
+#ifdef ARVORE_AVL
+        novo->altura = 1;
+#endif
     }
     return novo;
 }
 
-//Insere na árvore já em ordem, sem se importar com o balanceamento, retorna o ponteiro para o nó inserido
+#ifdef ARVORE_AVL
+int altura(no_t *no) {
+    return no ? no->altura : 0;
+}
+
+void atualiza_altura(no_t *no) {
+    int he = altura(NO(no->esq)), hd = altura(NO(no->dir));
+    no->altura = (he > hd ? he : hd) + 1;
+}
+#endif
+
+//Recalcula os campos da subárvore de um nó a partir dos filhos
+//(sem ARVORE_AUMENTADA nem ARVORE_AVL não há o que recalcular)
+void atualiza_no(no_t *no) {
+#ifdef ARVORE_AUMENTADA
+    no->tamanho = 1;
+    no->soma = no->chave;
+    no->minimo = no->maximo = no->chave;
+    no_t *esq = NO(no->esq), *dir = NO(no->dir);
+    if (esq) {
+        no->tamanho += esq->tamanho;
+        no->soma += esq->soma;
+        no->minimo = esq->minimo;
+    }
+    if (dir) {
+        no->tamanho += dir->tamanho;
+        no->soma += dir->soma;
+        no->maximo = dir->maximo;
+    }
+#endif
+#ifdef ARVORE_AVL
+    atualiza_altura(no);
+#endif
+}
+
+#ifdef ARVORE_AVL
+//Rotações simples, retornam a nova raiz da subárvore
+no_t *rotaciona_dir(no_t *no) {
+    no_t *filho = NO(no->esq);
+    no->esq = filho->dir;
+    filho->dir = LIG(no);
+    atualiza_no(no);
+    atualiza_no(filho);
+    return filho;
+}
+
+no_t *rotaciona_esq(no_t *no) {
+    no_t *filho = NO(no->dir);
+    no->dir = filho->esq;
+    filho->esq = LIG(no);
+    atualiza_no(no);
+    atualiza_no(filho);
+    return filho;
+}
+
+//Corrige o nó se a diferença de altura entre os filhos passou de 1
+no_t *balancear(no_t *no) {
+    atualiza_altura(no);
+    no_t *esq = NO(no->esq), *dir = NO(no->dir);
+    int fator = altura(esq) - altura(dir);
+
+    if (fator > 1) {
+        if (altura(NO(esq->esq)) < altura(NO(esq->dir)))
+            no->esq = LIG(rotaciona_esq(esq));
+        return rotaciona_dir(no);
+    }
+    if (fator < -1) {
+        if (altura(NO(dir->dir)) < altura(NO(dir->esq)))
+            no->dir = LIG(rotaciona_dir(dir));
+        return rotaciona_esq(no);
+    }
+    return no;
+}
+#endif
+
+//Insere na árvore já em ordem, retorna o ponteiro para a raiz
+//(sem ARVORE_AVL não se importa com o balanceamento)
+//Sem recursão: lugar aponta a ligação (raiz, esq ou dir) que vai
+//receber o nó novo, então entradas ordenadas não estouram a pilha; a
+//raiz vai para uma ligação local para ser tratada como os filhos
 no_t *inserir(no_t *raiz, int chave) {
-    if (raiz == NULL)
-        return criar_no(chave);
-    
-    if (chave < raiz->chave)
-        raiz->esq = inserir(raiz->esq, chave);
-    else if (chave > raiz->chave)
-        raiz->dir = inserir(raiz->dir, chave);
-    
-    return raiz;
+    lig_t ligacao_raiz = LIG(raiz), *lugar = &ligacao_raiz;
+    no_t *no;
+#ifdef ARVORE_AVL
+    //a altura de uma AVL com n nós é menor que 1,45·log2(n + 2)
+    lig_t *caminho[64];
+    int n = 0;
+
+    while ((no = NO(*lugar)) != NULL) {
+        if (chave == no->chave)
+            return raiz;
+        caminho[n++] = lugar;
+        lugar = chave < no->chave ? &no->esq : &no->dir;
+    }
+    *lugar = LIG(criar_no(chave));
+    //de baixo para cima, como na volta da recursão
+    while (n > 0) {
+        lugar = caminho[--n];
+        no = NO(*lugar);
+        atualiza_no(no);
+        *lugar = LIG(balancear(no));
+    }
+#elif defined(ARVORE_AUMENTADA)
+    //a chave repetida é ignorada, então confere antes de mexer nos
+    //campos do caminho, que são atualizados na descida
+    for (no = raiz; no; no = chave < no->chave ? NO(no->esq) : NO(no->dir))
+        if (chave == no->chave)
+            return raiz;
+    no_t *novo = criar_no(chave);
+    if (novo == NULL)
+        return raiz;
+    while ((no = NO(*lugar)) != NULL) {
+        no->tamanho++;
+        no->soma += chave;
+        if (chave < no->minimo) no->minimo = chave;
+        if (chave > no->maximo) no->maximo = chave;
+        lugar = chave < no->chave ? &no->esq : &no->dir;
+    }
+    *lugar = LIG(novo);
+#else
+    while ((no = NO(*lugar)) != NULL) {
+        if (chave == no->chave)
+            return raiz;
+        lugar = chave < no->chave ? &no->esq : &no->dir;
+    }
+    *lugar = LIG(criar_no(chave));
+#endif
+    return NO(ligacao_raiz);
+}
+void iniciar_pilha_vetor(pilha_vetor_t *p) {
+    p->cap = 64;
+    p->topo = 0;
+    p->nos = (no_t **)malloc(p->cap * sizeof(no_t *));
+}
+
+void empilhar_vetor(pilha_vetor_t *p, no_t *no) {
+    if (p->topo == p->cap) {
+        p->cap *= 2;
+        p->nos = (no_t **)realloc(p->nos, p->cap * sizeof(no_t *));
+    }
+    p->nos[p->topo++] = no;
+}
+
+//Árvores montadas por montar_de_vetor ficam num único bloco de nós;
+//liberar_arvore devolve o bloco quando o último nó dele é liberado
+#define MAX_BLOCOS_NOS 64
+
+typedef struct bloco_nos {
+    no_t *nos;
+    int n;
+    int vivos; // nós do bloco ainda não liberados
+} bloco_nos_t;
+
+bloco_nos_t blocos_nos[MAX_BLOCOS_NOS];
+int num_blocos_nos = 0;
+
+//Libera um nó, que pode ser de um bloco ou alocado sozinho
+void liberar_no(no_t *no) {
+    for (int i = 0; i < num_blocos_nos; i++) {
+        bloco_nos_t *b = &blocos_nos[i];
+        if (no >= b->nos && no < b->nos + b->n) {
+            if (--b->vivos == 0) {
+                free(b->nos);
+                *b = blocos_nos[--num_blocos_nos];
+            }
+            return;
+        }
+    }
+#ifdef ARVORE_ARENA
+    devolveArena(&arena_nos, no);
+#else
+    free(no);
+#endif
 }
-//libera a memória alocada para a árvore e seus nós
+
+//libera a memória alocada para a árvore e seus nós (só dela)
+//Sem recursão: enquanto a raiz tem filho esquerdo gira à direita,
+//senão libera a raiz e segue pela direita
 void liberar_arvore(no_t *raiz) {
-    if (raiz) {
-        liberar_arvore(raiz->esq);
-        liberar_arvore(raiz->dir);
-        free(raiz);
+    no_t *aux;
+
+    while (raiz) {
+        if (raiz->esq) {
+            aux = NO(raiz->esq);
+            raiz->esq = aux->dir;
+            aux->dir = LIG(raiz);
+            raiz = aux;
+        } else {
+            aux = NO(raiz->dir);
+            liberar_no(raiz);
+            raiz = aux;
+        }
+    }
+}
+
+#ifdef ARVORE_ARENA
+//Libera de uma vez todas as árvores, devolvendo a arena inteira sem
+//percorrer os nós; nenhuma árvore pode ser usada depois
+void liberar_todas_arvores() {
+    liberaArena(&arena_nos);
+}
+#endif
+
+//Política de montar_de_vetor para chaves repetidas
+#define DESCARTAR_DUPLICADAS 0 // como inserir(), que ignora repetidas
+#define MANTER_DUPLICADAS 1    // chaves iguais podem ficar dos dois lados
+
+int compara_int(const void *a, const void *b) {
+    int x = *(const int *)a, y = *(const int *)b;
+    return (x > y) - (x < y);
+}
+
+//Liga nos[*prox..] em pré-ordem como a árvore balanceada de chaves[ini..fim]
+//(com nos == NULL, cada nó vem de novo_no)
+no_t *montar_trecho(const int *chaves, int ini, int fim, no_t *nos, int *prox) {
+    if (ini > fim)
+        return NULL;
+    int meio = ini + (fim - ini) / 2;
+    no_t *no = nos ? &nos[(*prox)++] : novo_no();
+    no->chave = chaves[meio];
+    no->esq = LIG(montar_trecho(chaves, ini, meio - 1, nos, prox));
+    no->dir = LIG(montar_trecho(chaves, meio + 1, fim, nos, prox));
+    atualiza_no(no);
+    return no;
+}
+
+//Monta de uma vez a árvore de busca perfeitamente balanceada (altura
+//mínima) com as n chaves do vetor, que é ordenado no lugar se preciso e,
+//com DESCARTAR_DUPLICADAS, fica sem as repetidas; *n recebe o número de
+//nós. Vetor já ordenado sai em O(n), e todos os nós ocupam um só bloco
+//(alocado em pré-ordem, a ordem em que os percursos visitam os nós).
+//Pode ser misturada com inserir, dobraArvore e liberar_arvore.
+no_t *montar_de_vetor(int *chaves, int *n, int duplicadas) {
+    int i, m = *n, prox = 0;
+    no_t *nos;
+
+    for (i = 1; i < m && chaves[i - 1] <= chaves[i]; i++)
+        ;
+    if (i < m)
+        qsort(chaves, m, sizeof(int), compara_int);
+    if (duplicadas == DESCARTAR_DUPLICADAS && m > 0) {
+        int k = 1;
+        for (i = 1; i < m; i++)
+            if (chaves[i] != chaves[k - 1])
+                chaves[k++] = chaves[i];
+        m = k;
+    }
+    *n = m;
+    if (m == 0)
+        return NULL;
+
+#ifdef ARVORE_ARENA
+    // os nós já saem em sequência dos blocos da arena
+    nos = NULL;
+#else
+    // sem espaço na tabela de blocos, volta aos nós alocados um a um
+    nos = NULL;
+    if (num_blocos_nos < MAX_BLOCOS_NOS)
+        nos = (no_t *)malloc((size_t)m * sizeof(no_t));
+    if (nos != NULL)
+        blocos_nos[num_blocos_nos++] = (bloco_nos_t){ nos, m, m };
+#endif
+    return montar_trecho(chaves, 0, m - 1, nos, &prox);
+}
+
+//Percurso em ordem de Morris: devolve o próximo nó a visitar depois de
+//*atual e avança *atual. Usa o ponteiro dir do antecessor como caminho
+//de volta e o desfaz ao passar de novo, sem pilha nem recursão.
+//Retorna NULL quando o percurso termina.
+no_t *morris_proximo(no_t **atual) {
+    no_t *ant, *visitado;
+
+    while (*atual) {
+        if (NO((*atual)->esq) == NULL) {
+            visitado = *atual;
+            *atual = NO((*atual)->dir);
+            return visitado;
+        }
+        ant = NO((*atual)->esq);
+        while (ant->dir && NO(ant->dir) != *atual)
+            ant = NO(ant->dir);
+        if (NO(ant->dir) == NULL) {
+            ant->dir = LIG(*atual);
+            *atual = NO((*atual)->esq);
+        } else {
+            ant->dir = LIG(NULL);
+            visitado = *atual;
+            *atual = NO((*atual)->dir);
+            return visitado;
+        }
     }
+    return NULL;
 }
 
 //Imprime os elementos em ordem
 void em_ordem(no_t *raiz) {
-    if (raiz) {
-        em_ordem(raiz->esq);
-        printf("%d ", raiz->chave);
-        em_ordem(raiz->dir);
-    }
+    no_t *no;
+
+    while ((no = morris_proximo(&raiz)) != NULL)
+        printf("%d ", no->chave);
 }
 
 //Busca um elemento passado nos paramêtros e retorna o ponteiro para ele, utilizando recursão
@@ -68,111 +436,148 @@ struct no *busca_prof (no_t *atual, int elemento) {
     }
 
     struct no *result;
-    result = busca_prof(atual->esq, elemento);
+    result = busca_prof(NO(atual->esq), elemento);
     if(result){
         return result;
     }
-    result = busca_prof(atual->dir, elemento);
+    result = busca_prof(NO(atual->dir), elemento);
     return result;
 }
 
-// Função para empilhar um nó
-void empilhar(pilha_t **topo, no_t *no) {
-    pilha_t *novo = (pilha_t *)malloc(sizeof(pilha_t));
-    if (!novo) return;
-    novo->no = no;
-    novo->prox = *topo;
-    *topo = novo;
+//Pilhas reaproveitadas pelas buscas e percursos iterativos desta thread:
+//crescem quando precisam e só são liberadas no fim da thread, então
+//depois das primeiras chamadas uma busca na árvore inteira não faz
+//nenhuma alocação. Cada percurso em andamento tem a sua (pegar_pilha e
+//devolver_pilha funcionam como uma pilha de pilhas), então um percurso
+//pode chamar outro no meio sem estragar o caminho guardado
+#define MAX_PILHAS_ANINHADAS 8
+
+static _Thread_local pilha_vetor_t pilhas_thread[MAX_PILHAS_ANINHADAS];
+static _Thread_local int pilhas_em_uso = 0;
+
+//Pega uma pilha vazia da thread; devolver com devolver_pilha
+pilha_vetor_t *pegar_pilha() {
+    assert(pilhas_em_uso < MAX_PILHAS_ANINHADAS);
+    pilha_vetor_t *pilha = &pilhas_thread[pilhas_em_uso++];
+    if (pilha->nos == NULL)
+        iniciar_pilha_vetor(pilha);
+    pilha->topo = 0;
+    return pilha;
 }
 
-// Função para desempilhar um nó
-no_t *desempilhar(pilha_t **topo) {
-    if (*topo == NULL) return NULL;
-    pilha_t *temp = *topo;
-    no_t *no = temp->no;
-    *topo = temp->prox;
-    free(temp);
-    return no;
+//Devolve a pilha pega por último
+void devolver_pilha(pilha_vetor_t *pilha) {
+    assert(pilhas_em_uso > 0 && pilha == &pilhas_thread[pilhas_em_uso - 1]);
+    pilhas_em_uso--;
 }
 
-//Busca um elemento na árvore sem utilizar recursão
-no_t *busca_profSR(no_t *atual, int elemento) {
-    if (atual == NULL) return NULL;
+//Libera as pilhas da thread (nenhuma pode estar em uso)
+void liberar_pilhas_thread() {
+    assert(pilhas_em_uso == 0);
+    for (int i = 0; i < MAX_PILHAS_ANINHADAS; i++) {
+        free(pilhas_thread[i].nos);
+        pilhas_thread[i].nos = NULL;
+    }
+}
 
-    pilha_t *pilha = NULL;
-    empilhar(&pilha, atual);
+//Busca um elemento na árvore sem utilizar recursão, usando a pilha
+//fornecida por quem chama (que pode ser reaproveitada entre buscas)
+no_t *busca_profSR_pilha(no_t *atual, int elemento, pilha_vetor_t *pilha) {
+    pilha->topo = 0;
+    if (atual == NULL) return NULL;
 
-    while (pilha) {
-        no_t *no = desempilhar(&pilha);
+    empilhar_vetor(pilha, atual);
+    while (pilha->topo > 0) {
+        no_t *no = pilha->nos[--pilha->topo];
 
         if (no->chave == elemento) {
             return no; // Elemento encontrado
         }
 
-        if (no->dir) empilhar(&pilha, no->dir); // Empilha primeiro a direita
-        if (no->esq) empilhar(&pilha, no->esq); // Depois a esquerda
+        if (no->dir) empilhar_vetor(pilha, NO(no->dir)); // Empilha primeiro a direita
+        if (no->esq) empilhar_vetor(pilha, NO(no->esq)); // Depois a esquerda
     }
-    free(pilha);
     return NULL; // Elemento não encontrado
 }
 
+//Busca um elemento na árvore sem utilizar recursão
+no_t *busca_profSR(no_t *atual, int elemento) {
+    pilha_vetor_t *pilha = pegar_pilha();
+    no_t *no = busca_profSR_pilha(atual, elemento, pilha);
+
+    devolver_pilha(pilha);
+    return no;
+}
+
 //retorna a soma de todas as chaves da árvore
 int somaChave(struct no *atual) {
-    if (atual == NULL) {
-        return 0;
-    }
-    return atual->chave + somaChave(atual->esq) + somaChave(atual->dir);
+    struct no *no;
+    int soma = 0;
+
+    while ((no = morris_proximo(&atual)) != NULL)
+        soma += no->chave;
+    return soma;
 }
 
-//Busca o menor valor de chave na árvore
+//Busca o menor valor de chave na árvore (percorre todos os nós, pois
+//depois de paiMaior a árvore deixa de ser de busca)
 struct no *busca_minimo(struct no *atual) {
-    if (atual == NULL) {
-        return NULL;
-    }
+    struct no *no, *menor = NULL;
 
-    struct no *min_esq = busca_minimo(atual->esq);
-    struct no *min_dir = busca_minimo(atual->dir);
+    while ((no = morris_proximo(&atual)) != NULL)
+        if (menor == NULL || no->chave < menor->chave)
+            menor = no;
+    return menor;
+}
 
-    struct no *menor = atual;
-    if (min_esq != NULL && min_esq->chave < menor->chave) {
-        menor = min_esq;
+//Passo de paiMaior num nó cujos filhos já foram processados: o nó
+//fica com a maior chave entre a sua e as dos filhos
+void passo_pai_maior(struct no *no) {
+    struct no *esq = NO(no->esq), *dir = NO(no->dir);
+    int maior = no->chave;
+    if (esq != NULL && esq->chave > maior) {
+        maior = esq->chave;
     }
-    if (min_dir != NULL && min_dir->chave < menor->chave) {
-        menor = min_dir;
+    if (dir != NULL && dir->chave > maior) {
+        maior = dir->chave;
+    }
+    if (esq != NULL || dir != NULL) {
+        no->chave = maior;
     }
-
-    return menor;
 }
 
 //Rearranja a árvore para que os pais sempre sejam maiores que os filhos
+//Pós-ordem iterativa: um nó só é processado depois dos dois filhos
 void paiMaior(struct no *atual) {
-    if (atual == NULL) {
-        return;
-    }
-
-    paiMaior(atual->esq);
-    paiMaior(atual->dir);
+    pilha_vetor_t *pilha = pegar_pilha();
+    struct no *ultimo = NULL, *topo;
 
-    int maior = atual->chave;
-    if (atual->esq != NULL && atual->esq->chave > maior) {
-        maior = atual->esq->chave;
-    }
-    if (atual->dir != NULL && atual->dir->chave > maior) {
-        maior = atual->dir->chave;
-    }
+    while (atual || pilha->topo > 0) {
+        if (atual) {
+            empilhar_vetor(pilha, atual);
+            atual = NO(atual->esq);
+            continue;
+        }
+        topo = pilha->nos[pilha->topo - 1];
+        if (topo->dir && ultimo != NO(topo->dir)) {
+            atual = NO(topo->dir);
+            continue;
+        }
 
-    if (atual->esq != NULL || atual->dir != NULL) {
-        atual->chave = maior;
+        passo_pai_maior(topo);
+        ultimo = topo;
+        pilha->topo--;
     }
+    devolver_pilha(pilha);
 }
 
-//Dobra o tamanho da árvore utilizando os parametros especificados para pares e ímpares
-struct no *dobraArvore(struct no *atual) {
-    if (atual == NULL) {
-        return NULL;
-    }
-    // Cria um novo nó pai para o nó atual
-    struct no *novoPai = (struct no*)malloc(sizeof(struct no));
+//Cria o novo nó pai de atual usado por dobraArvore (sem tocar nos filhos)
+//Com ARVORE_AUMENTADA só o campo tamanho é mantido (é o que o corte das
+//versões paralelas usa): depois de dobrada, uma subárvore de s nós tem
+//2s, com o novo pai na raiz e atual com 2s - 1 (os demais campos deixam
+//de valer)
+struct no *novo_pai(struct no *atual) {
+    struct no *novoPai = novo_no();
     if (novoPai == NULL) {
         return NULL; 
     }
@@ -185,90 +590,1031 @@ struct no *dobraArvore(struct no *atual) {
 
     // O novo nó pai assume o lugar do nó atual na árvore
     if (atual->chave % 2 == 0) {
-        novoPai->esq = atual; // Nó atual se torna filho esquerdo
-        novoPai->dir = NULL;
+        novoPai->esq = LIG(atual); // Nó atual se torna filho esquerdo
+        novoPai->dir = LIG(NULL);
     } else {
-        novoPai->dir = atual; // Nó atual se torna filho direito
-        novoPai->esq = NULL;
+        novoPai->dir = LIG(atual); // Nó atual se torna filho direito
+        novoPai->esq = LIG(NULL);
     }
+#ifdef ARVORE_AUMENTADA
+    novoPai->tamanho = 2 * atual->tamanho;
+    atual->tamanho = 2 * atual->tamanho - 1;
+#endif
+    return novoPai;
+}
 
-    atual->esq = dobraArvore(atual->esq);
-    atual->dir = dobraArvore(atual->dir);
+//Dobra o tamanho da árvore utilizando os parametros especificados para pares e ímpares
+//Sem recursão: a pilha guarda os nós originais cujos filhos ainda não
+//ganharam o novo pai
+struct no *dobraArvore(struct no *atual) {
+    pilha_vetor_t pilha;
+    struct no *no, *filho;
 
+    if (atual == NULL) {
+        return NULL;
+    }
+    // Cria um novo nó pai para o nó atual
+    struct no *novoPai = novo_pai(atual);
+    if (novoPai == NULL) {
+        return NULL; 
+    }
+
+    iniciar_pilha_vetor(&pilha);
+    empilhar_vetor(&pilha, atual);
+    while (pilha.topo > 0) {
+        no = pilha.nos[--pilha.topo];
+        if ((filho = NO(no->dir)) != NULL && (no->dir = LIG(novo_pai(filho))))
+            empilhar_vetor(&pilha, filho);
+        if ((filho = NO(no->esq)) != NULL && (no->esq = LIG(novo_pai(filho))))
+            empilhar_vetor(&pilha, filho); // a esquerda sai primeiro
+    }
+    free(pilha.nos);
     return novoPai;
 }
 //Coloca o maior elemento da árvore na raiz
+//(a chamada recursiva no filho trocado virou a volta do laço)
 void maiorNaRaiz(struct no *atual) {
-    if (atual == NULL) {
-        return;
-    }
+    while (atual != NULL) {
+        paiMaior(atual);
 
-    paiMaior(atual);
 
+        struct no *maior = atual;
+        struct no *esq = NO(atual->esq);
+        struct no *dir = NO(atual->dir);
 
-    struct no *maior = atual;
-    struct no *esq = atual->esq;
-    struct no *dir = atual->dir;
+        if (esq != NULL && esq->chave > maior->chave) {
+            maior = esq;
+        }
+        if (dir != NULL && dir->chave > maior->chave) {
+            maior = dir;
+        }
 
-    if (esq != NULL && esq->chave > maior->chave) {
-        maior = esq;
+        if (maior == atual) {
+            return;
+        }
+        int temp = atual->chave;
+        atual->chave = maior->chave;
+        maior->chave = temp;
+        atual = maior;
     }
-    if (dir != NULL && dir->chave > maior->chave) {
-        maior = dir;
+}
+
+//Versão original de ordenaPeloMaior: roda maiorNaRaiz (e portanto um
+//paiMaior da subárvore inteira) em cada nó, O(n·h) a O(n²). Mantida só
+//como referência de tempo.
+void ordenaPeloMaior_referencia(struct no *atual) {
+    if (atual == NULL) {
+        return;
     }
 
-    if (maior != atual) {
+    maiorNaRaiz(atual);
+
+    ordenaPeloMaior_referencia(NO(atual->esq));
+    ordenaPeloMaior_referencia(NO(atual->dir));
+}
+
+//Desce a chave do nó trocando-a com a do maior filho até que nenhum
+//filho seja maior (peneiramento de heap)
+void peneirar(struct no *atual) {
+    while (atual) {
+        struct no *maior = atual, *esq = NO(atual->esq), *dir = NO(atual->dir);
+        if (esq && esq->chave > maior->chave) maior = esq;
+        if (dir && dir->chave > maior->chave) maior = dir;
+        if (maior == atual) return;
+
         int temp = atual->chave;
         atual->chave = maior->chave;
         maior->chave = temp;
-        maiorNaRaiz(maior);
+        atual = maior;
     }
 }
 
-//Rearranja os elementos para que estejam em ordem
+//Transforma a árvore em um heap de máximo sem perder nenhuma chave,
+//peneirando os nós de baixo para cima (pós-ordem), como o heapify de
+//Floyd: O(n) numa árvore balanceada, O(n·h) no pior caso numa degenerada
+void heapificar(struct no *atual) {
+    pilha_vetor_t *pilha = pegar_pilha();
+    struct no *ultimo = NULL, *topo;
+
+    while (atual || pilha->topo > 0) {
+        if (atual) {
+            empilhar_vetor(pilha, atual);
+            atual = NO(atual->esq);
+            continue;
+        }
+        topo = pilha->nos[pilha->topo - 1];
+        if (topo->dir && ultimo != NO(topo->dir)) {
+            atual = NO(topo->dir);
+            continue;
+        }
+        peneirar(topo); // as duas subárvores já são heaps
+        ultimo = topo;
+        pilha->topo--;
+    }
+    devolver_pilha(pilha);
+}
+
+//Rearranja os elementos para que cada pai seja maior que os filhos
 void ordenaPeloMaior(struct no *atual) {
-    if (atual == NULL) {
-        return;
+    heapificar(atual);
+}
+
+//Heap de máximo em vetor: os filhos de v[i] ficam em v[2i+1] e v[2i+2]
+void peneirar_vetor(int *v, int n, int i) {
+    int chave = v[i];
+
+    while (2 * i + 1 < n) {
+        int filho = 2 * i + 1;
+        if (filho + 1 < n && v[filho + 1] > v[filho])
+            filho++;
+        if (v[filho] <= chave)
+            break;
+        v[i] = v[filho];
+        i = filho;
     }
+    v[i] = chave;
+}
 
-    maiorNaRaiz(atual);
+void heapificar_vetor(int *v, int n) {
+    for (int i = n / 2 - 1; i >= 0; i--)
+        peneirar_vetor(v, n, i);
+}
+
+//Copia as chaves da árvore para um vetor e monta nele um heap de máximo
+//em O(n); devolve o vetor (liberar com free) e o tamanho em *n
+int *heap_da_arvore(struct no *raiz, int *n) {
+    struct no *no, *it = raiz;
+    int *v, i = 0;
 
-    ordenaPeloMaior(atual->esq);
-    ordenaPeloMaior(atual->dir);
+    *n = 0;
+    while ((no = morris_proximo(&it)) != NULL)
+        (*n)++;
+    v = (int *)malloc((*n > 0 ? *n : 1) * sizeof(int));
+    it = raiz;
+    while ((no = morris_proximo(&it)) != NULL)
+        v[i++] = no->chave;
+    heapificar_vetor(v, *n);
+    return v;
 }
 
+//Confere se nenhum filho é maior que o pai
+int eh_heap(struct no *atual) {
+    pilha_vetor_t *pilha;
+    int ok = 1;
 
+    if (atual == NULL) return 1;
+    pilha = pegar_pilha();
+    empilhar_vetor(pilha, atual);
+    while (ok && pilha->topo > 0) {
+        struct no *no = pilha->nos[--pilha->topo];
+        struct no *esq = NO(no->esq), *dir = NO(no->dir);
+        if (esq) {
+            if (esq->chave > no->chave) ok = 0;
+            empilhar_vetor(pilha, esq);
+        }
+        if (dir) {
+            if (dir->chave > no->chave) ok = 0;
+            empilhar_vetor(pilha, dir);
+        }
+    }
+    devolver_pilha(pilha);
+    return ok;
+}
+
+
+//Busca em árvore de busca, descendo só pelo lado que pode ter o elemento
 struct no *buscaBinaria(struct no *atual, int elemento){
-    if(atual == NULL){
+    while(atual != NULL && atual->chave != elemento){
+        if(atual->chave > elemento){
+            atual = NO(atual->esq);
+        }else{
+            atual = NO(atual->dir);
+        }
+    }
+    return atual;
+}
+
+
+#ifdef ARVORE_AUMENTADA
+//Consultas em O(1) ou O(altura) usando os campos de subárvore.
+//somaChave e busca_minimo continuam percorrendo a árvore inteira e
+//servem de referência (e funcionam mesmo depois de paiMaior etc.)
+
+//Soma de todas as chaves, em O(1)
+long long soma_arvore(no_t *raiz) {
+    return raiz ? raiz->soma : 0;
+}
+
+//Menor e maior chave, em O(1) (INT_MAX e INT_MIN na árvore vazia)
+int minimo_arvore(no_t *raiz) {
+    return raiz ? raiz->minimo : INT_MAX;
+}
+
+int maximo_arvore(no_t *raiz) {
+    return raiz ? raiz->maximo : INT_MIN;
+}
+
+//Quantidade de chaves menores que chave (posição que ela ocupa em ordem)
+int posicao(no_t *raiz, int chave) {
+    int menores = 0;
+
+    while (raiz) {
+        if (chave <= raiz->chave) {
+            raiz = NO(raiz->esq);
+        } else {
+            menores += 1 + (raiz->esq ? NO(raiz->esq)->tamanho : 0);
+            raiz = NO(raiz->dir);
+        }
+    }
+    return menores;
+}
+
+//k-ésima menor chave (k a partir de 1), ou NULL se k estiver fora da árvore
+no_t *k_esimo(no_t *raiz, int k) {
+    while (raiz) {
+        int tam_esq = raiz->esq ? NO(raiz->esq)->tamanho : 0;
+        if (k <= tam_esq) {
+            raiz = NO(raiz->esq);
+        } else if (k == tam_esq + 1) {
+            return raiz;
+        } else {
+            k -= tam_esq + 1;
+            raiz = NO(raiz->dir);
+        }
+    }
+    return NULL;
+}
+
+//Soma das chaves menores ou iguais a chave
+long long soma_ate(no_t *raiz, int chave) {
+    long long soma = 0;
+
+    while (raiz) {
+        if (chave < raiz->chave) {
+            raiz = NO(raiz->esq);
+        } else {
+            soma += raiz->chave + (raiz->esq ? NO(raiz->esq)->soma : 0);
+            raiz = NO(raiz->dir);
+        }
+    }
+    return soma;
+}
+
+//Soma das chaves no intervalo [ini, fim]
+long long soma_intervalo(no_t *raiz, int ini, int fim) {
+    if (ini > fim)
+        return 0;
+    return soma_ate(raiz, fim) - (ini > INT_MIN ? soma_ate(raiz, ini - 1) : 0);
+}
+
+//Compara as consultas acima com percursos completos em árvores aleatórias;
+//retorna o número de divergências
+int verifica_consultas(int n, int rodadas) {
+    int erros = 0;
+
+    for (int r = 0; r < rodadas; r++) {
+        no_t *arvore = NULL, *no, *it;
+        int tam = aleat(0, n);
+
+        for (int i = 0; i < tam; i++)
+            arvore = inserir(arvore, aleat(-1000, 1000));
+
+        // tamanho, soma, mínimo e máximo contra os percursos de referência
+        int contados = 0, maior = INT_MIN;
+        it = arvore;
+        while ((no = morris_proximo(&it)) != NULL) {
+            contados++;
+            if (no->chave > maior) maior = no->chave;
+        }
+        no = busca_minimo(arvore);
+        if ((arvore ? arvore->tamanho : 0) != contados) erros++;
+        if (soma_arvore(arvore) != somaChave(arvore)) erros++;
+        if (minimo_arvore(arvore) != (no ? no->chave : INT_MAX)) erros++;
+        if (maximo_arvore(arvore) != maior) erros++;
+
+        // posição, k-ésimo e soma de intervalo contra uma passada em ordem
+        for (int q = 0; q < 20; q++) {
+            int a = aleat(-1100, 1100), b = aleat(-1100, 1100), k = aleat(0, contados + 1);
+            int menores = 0, ordem = 0;
+            long long soma = 0;
+            no_t *kesimo = NULL;
+
+            it = arvore;
+            while ((no = morris_proximo(&it)) != NULL) {
+                if (no->chave < a) menores++;
+                if (no->chave >= a && no->chave <= b) soma += no->chave;
+                if (++ordem == k) kesimo = no;
+            }
+            if (posicao(arvore, a) != menores) erros++;
+            if (soma_intervalo(arvore, a, b) != soma) erros++;
+            if (k_esimo(arvore, k) != kesimo) erros++;
+        }
+        liberar_arvore(arvore);
+    }
+    printf("verifica_consultas: %d rodadas, %d divergencias\n", rodadas, erros);
+    return erros;
+}
+#endif
+
+//Preenche as posições da subárvore k do vetor de Eytzinger com as chaves
+//ordenadas a partir de *prox (a profundidade é log n)
+void preencher_eytzinger(arvore_eytzinger_t *a, const int *ordenadas, int *prox, int k) {
+    if (k > a->n)
+        return;
+    preencher_eytzinger(a, ordenadas, prox, 2 * k);
+    a->chaves[k] = ordenadas[(*prox)++];
+    preencher_eytzinger(a, ordenadas, prox, 2 * k + 1);
+}
+
+//Copia as chaves da árvore de busca, em ordem, para um vetor de Eytzinger
+//alinhado à linha de cache. A árvore original não é alterada.
+arvore_eytzinger_t congelar_arvore(no_t *raiz) {
+    arvore_eytzinger_t a;
+    no_t *no, *it = raiz;
+    int *ordenadas, i = 0, prox = 0;
+    size_t bytes;
+
+    a.n = 0;
+    while ((no = morris_proximo(&it)) != NULL)
+        a.n++;
+    ordenadas = (int *)malloc((a.n > 0 ? a.n : 1) * sizeof(int));
+    it = raiz;
+    while ((no = morris_proximo(&it)) != NULL)
+        ordenadas[i++] = no->chave;
+
+    bytes = ((a.n + 1) * sizeof(int) + 63) / 64 * 64;
+    a.chaves = (int *)aligned_alloc(64, bytes);
+    preencher_eytzinger(&a, ordenadas, &prox, 1);
+    free(ordenadas);
+    return a;
+}
+
+//Busca sem desvios dependentes da chave: desce sempre até passar do fim
+//do vetor, indo para 2k ou 2k+1 conforme a comparação, e buscando
+//antecipadamente a linha com os descendentes 4 níveis abaixo. No fim,
+//os bits 1 finais de k marcam as descidas à direita depois da última à
+//esquerda; removê-los dá o menor elemento >= chave.
+//Retorna a posição da chave no vetor ou 0 se ela não existir.
+int busca_eytzinger(const arvore_eytzinger_t *a, int chave) {
+    int k = 1;
+
+    while (k <= a->n) {
+        __builtin_prefetch(a->chaves + 16 * k);
+        k = 2 * k + (a->chaves[k] < chave);
+    }
+    k >>= __builtin_ffs(~k);
+    return (k != 0 && a->chaves[k] == chave) ? k : 0;
+}
+
+void liberar_eytzinger(arvore_eytzinger_t *a) {
+    free(a->chaves);
+    a->chaves = NULL;
+    a->n = 0;
+}
+
+//Tempo de relógio em milissegundos
+double agora_ms() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1000.0 + ts.tv_nsec / 1e6;
+}
+
+//Monta uma árvore de busca perfeitamente balanceada com as chaves ini..fim
+no_t *montar_balanceada(int ini, int fim) {
+    if (ini > fim)
         return NULL;
+    int meio = ini + (fim - ini) / 2;
+    no_t *no = criar_no(meio);
+    no->esq = LIG(montar_balanceada(ini, meio - 1));
+    no->dir = LIG(montar_balanceada(meio + 1, fim));
+    atualiza_no(no);
+    return no;
+}
+
+//Monta a lista encadeada pela direita que n inserções crescentes gerariam
+no_t *montar_degenerada(int n) {
+    no_t *raiz = NULL;
+    while (n > 0) {
+        no_t *no = criar_no(--n);
+        no->dir = LIG(raiz);
+        atualiza_no(no);
+        raiz = no;
     }
+    return raiz;
+}
 
-    if(atual->chave == elemento){
-        return atual;
+//Compara as buscas em profundidade procurando uma chave que não existe
+//(percorre a árvore inteira). A recursiva só roda na árvore balanceada.
+int benchmark(int n, int repeticoes) {
+    double t0;
+    int r;
+
+    printf("%-12s %-12s %10s\n", "arvore", "busca", "ms/busca");
+    for (int degenerada = 0; degenerada <= 1; degenerada++) {
+        no_t *arvore = degenerada ? montar_degenerada(n) : montar_balanceada(0, n - 1);
+        const char *nome = degenerada ? "degenerada" : "balanceada";
+
+        busca_profSR(arvore, -1); // aquece a pilha da thread
+        t0 = agora_ms();
+        for (r = 0; r < repeticoes; r++)
+            if (busca_profSR(arvore, -1)) return 1;
+        printf("%-12s %-12s %10.1f\n", nome, "iterativa", (agora_ms() - t0) / repeticoes);
+
+        if (!degenerada) {
+            t0 = agora_ms();
+            for (r = 0; r < repeticoes; r++)
+                if (busca_prof(arvore, -1)) return 1;
+            printf("%-12s %-12s %10.1f\n", nome, "recursiva", (agora_ms() - t0) / repeticoes);
+        }
+        liberar_arvore(arvore);
     }
-    if(atual->chave > elemento){
-        return buscaBinaria(atual->esq, elemento);
+    return 0;
+}
+
+//Soma das chaves em long long (somaChave estoura com milhões de nós)
+long long soma_completa(no_t *raiz) {
+    no_t *no;
+    long long soma = 0;
+
+    while ((no = morris_proximo(&raiz)) != NULL)
+        soma += no->chave;
+    return soma;
+}
+
+//Mede heapificar, o heap em vetor e a ordenaPeloMaior original numa árvore
+//balanceada de busca com n chaves (o pior caso para o heap: em ordem
+//crescente, quase todas as chaves precisam descer)
+int benchmark_heap(int n) {
+    double t0;
+    int tam, ok = 1;
+
+    printf("%-26s %10s %8s\n", "heap de maximo", "ms", "heap?");
+
+    no_t *arvore = montar_balanceada(0, n - 1);
+    long long soma = soma_completa(arvore);
+    t0 = agora_ms();
+    heapificar(arvore);
+    double ms = agora_ms() - t0;
+    int valido = eh_heap(arvore) && soma_completa(arvore) == soma;
+    printf("%-26s %10.1f %8s\n", "heapificar (ponteiros)", ms, valido ? "sim" : "NAO");
+    ok &= valido;
+    liberar_arvore(arvore);
+
+    arvore = montar_balanceada(0, n - 1);
+    t0 = agora_ms();
+    int *v = heap_da_arvore(arvore, &tam);
+    ms = agora_ms() - t0;
+    valido = tam == n;
+    for (int i = 1; i < tam && valido; i++)
+        valido = v[(i - 1) / 2] >= v[i];
+    printf("%-26s %10.1f %8s\n", "copia + heap em vetor", ms, valido ? "sim" : "NAO");
+    ok &= valido;
+    free(v);
+
+    t0 = agora_ms();
+    ordenaPeloMaior_referencia(arvore);
+    ms = agora_ms() - t0;
+    printf("%-26s %10.1f %8s\n", "ordenaPeloMaior original", ms, eh_heap(arvore) ? "sim" : "NAO");
+    liberar_arvore(arvore);
+    return !ok;
+}
+
+//Compara buscaBinaria com a busca na árvore congelada, com n chaves
+//inseridas em ordem aleatória e m buscas (metade delas sem sucesso)
+int benchmark_eytzinger(int n, int m) {
+    no_t *arvore = NULL;
+    int *consultas = (int *)malloc(m * sizeof(int));
+    int achados_arv = 0, achados_vet = 0, i;
+    double t0;
+
+    srand(7);
+    for (i = 0; i < n; i++)
+        arvore = inserir(arvore, (int)(((unsigned)rand() << 16 ^ (unsigned)rand()) % (2u * n)));
+    for (i = 0; i < m; i++)
+        consultas[i] = (int)(((unsigned)rand() << 16 ^ (unsigned)rand()) % (2u * n));
+
+    t0 = agora_ms();
+    arvore_eytzinger_t congelada = congelar_arvore(arvore);
+    printf("congelar %d chaves: %.1f ms\n", congelada.n, agora_ms() - t0);
+
+    t0 = agora_ms();
+    for (i = 0; i < m; i++)
+        achados_arv += buscaBinaria(arvore, consultas[i]) != NULL;
+    double ms_arv = agora_ms() - t0;
+
+    t0 = agora_ms();
+    for (i = 0; i < m; i++)
+        achados_vet += busca_eytzinger(&congelada, consultas[i]) != 0;
+    double ms_vet = agora_ms() - t0;
+
+    printf("%-14s %10.1f ns/busca\n", "buscaBinaria", ms_arv * 1e6 / m);
+    printf("%-14s %10.1f ns/busca%s\n", "eytzinger", ms_vet * 1e6 / m,
+           achados_arv == achados_vet ? "" : "  RESULTADOS DIFERENTES");
+
+    liberar_eytzinger(&congelada);
+    liberar_arvore(arvore);
+    free(consultas);
+    return achados_arv != achados_vet;
+}
+
+#ifdef ARVORE_PARALELA
+//Fork/join com roubo de tarefas. Cada trabalhador (a thread principal é
+//o trabalhador 0) tem um deque de tarefas: empilha e retira as suas pela
+//base, e quem está sem trabalho rouba pelo topo do deque de outro. A
+//estrutura da tarefa fica na pilha de execução de quem a disparou, que
+//não retorna antes de aguardá-la. Enquanto espera, um trabalhador executa
+//outras tarefas (normalmente a própria, se ninguém a roubou).
+//Subárvores com menos de corte_paralelo nós são processadas em sequência,
+//e só se dispara uma tarefa num nó em que os dois filhos passam do corte;
+//num nó com um só filho grande, o outro é feito na hora e o percurso
+//desce pelo grande num laço (uma lista degenerada não tem subárvores
+//independentes para dividir, mas também não aprofunda a recursão).
+#define MIN_CORTE_PARALELO 4096
+#define MAX_TRABALHADORES 64
+#define TAM_DEQUE 256
+
+typedef struct tarefa {
+    void (*executar)(struct tarefa *);
+    no_t *no;
+    long long soma;   // resultado de somaChave
+    no_t *nova_raiz;  // resultado de dobraArvore
+    atomic_int pronta;
+} tarefa_t;
+
+typedef struct deque {
+    pthread_mutex_t trava;
+    tarefa_t *itens[TAM_DEQUE];
+    int base, topo; // tarefas em itens[base..topo)
+} deque_t;
+
+deque_t deques[MAX_TRABALHADORES];
+pthread_t threads_pool[MAX_TRABALHADORES];
+int num_trabalhadores = 1;
+int corte_paralelo = MIN_CORTE_PARALELO;
+atomic_int pool_encerrando;
+static _Thread_local int id_trabalhador = 0;
+static _Thread_local unsigned int semente_roubo = 0;
+
+void disparar(tarefa_t *t) {
+    deque_t *d = &deques[id_trabalhador];
+
+    atomic_store_explicit(&t->pronta, 0, memory_order_relaxed);
+    pthread_mutex_lock(&d->trava);
+    if (d->topo == TAM_DEQUE) { // só em árvores muito desequilibradas
+        pthread_mutex_unlock(&d->trava);
+        t->executar(t);
+        atomic_store_explicit(&t->pronta, 1, memory_order_release);
+        return;
     }
-    if(atual->chave < elemento){
-        return buscaBinaria(atual->dir, elemento);
+    d->itens[d->topo++] = t;
+    pthread_mutex_unlock(&d->trava);
+}
+
+//Retira a tarefa mais recente do próprio deque (ou NULL)
+tarefa_t *retirar_propria() {
+    deque_t *d = &deques[id_trabalhador];
+    tarefa_t *t = NULL;
+
+    pthread_mutex_lock(&d->trava);
+    if (d->topo > d->base)
+        t = d->itens[--d->topo];
+    if (d->topo == d->base)
+        d->topo = d->base = 0;
+    pthread_mutex_unlock(&d->trava);
+    return t;
+}
+
+//Rouba a tarefa mais antiga do deque de um trabalhador sorteado (ou NULL)
+tarefa_t *roubar() {
+    tarefa_t *t = NULL;
+
+    if (num_trabalhadores < 2)
+        return NULL;
+    if (semente_roubo == 0)
+        semente_roubo = 2654435761u * (id_trabalhador + 1);
+    semente_roubo ^= semente_roubo << 13;
+    semente_roubo ^= semente_roubo >> 17;
+    semente_roubo ^= semente_roubo << 5;
+    int vitima = semente_roubo % num_trabalhadores;
+    if (vitima == id_trabalhador)
+        return NULL;
+
+    deque_t *d = &deques[vitima];
+    pthread_mutex_lock(&d->trava);
+    if (d->topo > d->base)
+        t = d->itens[d->base++];
+    pthread_mutex_unlock(&d->trava);
+    return t;
+}
+
+void executar_tarefa(tarefa_t *t) {
+    t->executar(t);
+    atomic_store_explicit(&t->pronta, 1, memory_order_release);
+}
+
+//Espera t terminar, executando outras tarefas enquanto isso
+void aguardar(tarefa_t *t) {
+    tarefa_t *outra;
+
+    while (!atomic_load_explicit(&t->pronta, memory_order_acquire)) {
+        if ((outra = retirar_propria()) != NULL || (outra = roubar()) != NULL)
+            executar_tarefa(outra);
+        else
+            sched_yield();
     }
-    
 }
 
+void *laco_trabalhador(void *arg) {
+    tarefa_t *t;
+
+    id_trabalhador = (int)(long)arg;
+    while (!atomic_load(&pool_encerrando)) {
+        if ((t = roubar()) != NULL)
+            executar_tarefa(t);
+        else
+            sched_yield();
+    }
+    liberar_pilhas_thread();
+    return NULL;
+}
+
+//Cria n - 1 threads; a principal é o trabalhador 0
+void iniciar_pool(int n) {
+    if (n < 1) n = 1;
+    if (n > MAX_TRABALHADORES) n = MAX_TRABALHADORES;
+    num_trabalhadores = n;
+    atomic_store(&pool_encerrando, 0);
+    for (int i = 0; i < n; i++) {
+        pthread_mutex_init(&deques[i].trava, NULL);
+        deques[i].base = deques[i].topo = 0;
+    }
+    for (int i = 1; i < n; i++)
+        pthread_create(&threads_pool[i], NULL, laco_trabalhador, (void *)(long)i);
+}
+
+void encerrar_pool() {
+    atomic_store(&pool_encerrando, 1);
+    for (int i = 1; i < num_trabalhadores; i++)
+        pthread_join(threads_pool[i], NULL);
+    for (int i = 0; i < num_trabalhadores; i++)
+        pthread_mutex_destroy(&deques[i].trava);
+    num_trabalhadores = 1;
+}
+
+long long soma_paralela(no_t *no);
+void pai_maior_paralelo(no_t *no);
+no_t *dobra_paralela(no_t *no);
+
+void tarefa_soma(tarefa_t *t) { t->soma = soma_paralela(t->no); }
+void tarefa_pai_maior(tarefa_t *t) { pai_maior_paralelo(t->no); }
+void tarefa_dobra(tarefa_t *t) { t->nova_raiz = dobra_paralela(t->no); }
+
+int tamanho_sub(no_t *no) {
+    return no ? no->tamanho : 0;
+}
+
+//Cerca de 16 tarefas por trabalhador, pelo tamanho da árvore inteira
+void definir_corte(no_t *raiz) {
+    corte_paralelo = tamanho_sub(raiz) / (16 * num_trabalhadores);
+    if (corte_paralelo < MIN_CORTE_PARALELO)
+        corte_paralelo = MIN_CORTE_PARALELO;
+}
+
+long long soma_paralela(no_t *no) {
+    long long soma = 0;
+
+    while (no != NULL) {
+        if (no->tamanho < corte_paralelo)
+            return soma + soma_completa(no);
+        if (tamanho_sub(no->esq) >= corte_paralelo && tamanho_sub(no->dir) >= corte_paralelo) {
+            tarefa_t esq = { .executar = tarefa_soma, .no = no->esq };
+            disparar(&esq);
+            soma += soma_paralela(no->dir);
+            aguardar(&esq);
+            return soma + no->chave + esq.soma;
+        }
+        // só um filho grande: o pequeno em sequência, e desce pelo grande
+        soma += no->chave;
+        if (tamanho_sub(no->esq) >= tamanho_sub(no->dir)) {
+            soma += soma_completa(no->dir);
+            no = no->esq;
+        } else {
+            soma += soma_completa(no->esq);
+            no = no->dir;
+        }
+    }
+    return soma;
+}
+
+void pai_maior_paralelo(no_t *no) {
+    pilha_vetor_t caminho; // nós por onde o laço desceu, para a volta
+
+    iniciar_pilha_vetor(&caminho);
+    while (no != NULL) {
+        if (no->tamanho < corte_paralelo) {
+            paiMaior(no);
+            break;
+        }
+        if (tamanho_sub(no->esq) >= corte_paralelo && tamanho_sub(no->dir) >= corte_paralelo) {
+            tarefa_t esq = { .executar = tarefa_pai_maior, .no = no->esq };
+            disparar(&esq);
+            pai_maior_paralelo(no->dir);
+            aguardar(&esq);
+            passo_pai_maior(no);
+            break;
+        }
+        empilhar_vetor(&caminho, no);
+        if (tamanho_sub(no->esq) >= tamanho_sub(no->dir)) {
+            paiMaior(no->dir);
+            no = no->esq;
+        } else {
+            paiMaior(no->esq);
+            no = no->dir;
+        }
+    }
+    // de baixo para cima: os dois filhos de cada nó já estão prontos
+    while (caminho.topo > 0)
+        passo_pai_maior(caminho.nos[--caminho.topo]);
+    free(caminho.nos);
+}
+
+no_t *dobra_paralela(no_t *no) {
+    no_t *raiz = NULL, **lugar = &raiz;
+
+    while (no != NULL) {
+        if (no->tamanho < corte_paralelo) {
+            *lugar = dobraArvore(no);
+            break;
+        }
+        int tam_esq = tamanho_sub(no->esq), tam_dir = tamanho_sub(no->dir);
+        no_t *novoPai = novo_pai(no);
+        if (novoPai == NULL) {
+            *lugar = NULL;
+            break;
+        }
+        *lugar = novoPai;
+        if (tam_esq >= corte_paralelo && tam_dir >= corte_paralelo) {
+            tarefa_t esq = { .executar = tarefa_dobra, .no = no->esq };
+            disparar(&esq);
+            no->dir = dobra_paralela(no->dir);
+            aguardar(&esq);
+            no->esq = esq.nova_raiz;
+            break;
+        }
+        // o filho pequeno em sequência; o grande recebe o novo pai na volta
+        if (tam_esq >= tam_dir) {
+            no->dir = dobraArvore(no->dir);
+            lugar = &no->esq;
+            no = no->esq;
+        } else {
+            no->esq = dobraArvore(no->esq);
+            lugar = &no->dir;
+            no = no->dir;
+        }
+    }
+    return raiz;
+}
+
+//Versões paralelas (chamar da thread principal, com o pool iniciado)
+long long somaChave_paralela(no_t *raiz) {
+    definir_corte(raiz);
+    return soma_paralela(raiz);
+}
+
+void paiMaior_paralelo(no_t *raiz) {
+    definir_corte(raiz);
+    pai_maior_paralelo(raiz);
+}
+
+no_t *dobraArvore_paralela(no_t *raiz) {
+    definir_corte(raiz);
+    return dobra_paralela(raiz);
+}
+
+//Resumo das chaves e da forma da árvore (pré-ordem, com os filhos vazios
+//marcados), para comparar duas árvores sem guardar uma cópia
+unsigned long long assinatura_arvore(no_t *raiz) {
+    pilha_vetor_t *pilha = pegar_pilha();
+    unsigned long long h = 1469598103934665603ull;
+
+    empilhar_vetor(pilha, raiz);
+    while (pilha->topo > 0) {
+        no_t *no = pilha->nos[--pilha->topo];
+        h = (h ^ (no ? (unsigned int)no->chave + 1ull : 0)) * 1099511628211ull;
+        if (no) {
+            empilhar_vetor(pilha, no->dir);
+            empilhar_vetor(pilha, no->esq);
+        }
+    }
+    devolver_pilha(pilha);
+    return h;
+}
+
+//Mede as três operações com 1, 2, 4, ... max_threads trabalhadores numa
+//árvore balanceada e numa degenerada de n nós, conferindo cada resultado
+//com o das versões sequenciais aplicadas a uma árvore idêntica
+int benchmark_paralelo(int n, int max_threads) {
+    int erros = 0;
+    double t0, t_soma, t_pai, t_dobra;
+
+    printf("%-12s %-8s %12s %12s %12s\n", "arvore", "threads", "soma (ms)", "paiMaior", "dobra");
+    for (int degenerada = 0; degenerada <= 1; degenerada++) {
+        const char *nome = degenerada ? "degenerada" : "balanceada";
+
+        // referência: soma_completa, dobraArvore e paiMaior em sequência
+        no_t *ref = degenerada ? montar_degenerada(n) : montar_balanceada(0, n - 1);
+        long long soma_ref = soma_completa(ref);
+        ref = dobraArvore(ref);
+        unsigned long long dobrada_ref = assinatura_arvore(ref);
+        paiMaior(ref);
+        unsigned long long pai_maior_ref = assinatura_arvore(ref);
+        liberar_arvore(ref);
+
+        for (int n_threads = 1; n_threads <= max_threads; n_threads *= 2) {
+            // cópia recém-montada a cada rodada, para não acumular nós
+            no_t *copia = degenerada ? montar_degenerada(n) : montar_balanceada(0, n - 1);
+            iniciar_pool(n_threads);
+
+            t0 = agora_ms();
+            erros += somaChave_paralela(copia) != soma_ref;
+            t_soma = agora_ms() - t0;
+
+            t0 = agora_ms();
+            copia = dobraArvore_paralela(copia);
+            t_dobra = agora_ms() - t0;
+            erros += assinatura_arvore(copia) != dobrada_ref;
+
+            t0 = agora_ms();
+            paiMaior_paralelo(copia);
+            t_pai = agora_ms() - t0;
+            erros += assinatura_arvore(copia) != pai_maior_ref;
+
+            encerrar_pool();
+            liberar_arvore(copia);
+            printf("%-12s %-8d %12.1f %12.1f %12.1f\n", nome, n_threads, t_soma, t_pai, t_dobra);
+        }
+    }
+    printf("%d nucleos disponiveis, %d erros\n", (int)sysconf(_SC_NPROCESSORS_ONLN), erros);
+    return erros != 0;
+}
+#endif
+
+//Confere se a árvore tem altura mínima: em todo nó os tamanhos das
+//subárvores esquerda e direita diferem de no máximo 1
+//Os tamanhos são calculados em pós-ordem, sem o campo de ARVORE_AUMENTADA:
+//ordem recebe os nós em pós-ordem invertida e tamanhos faz de pilha (no
+//topo, o tamanho da subárvore direita e, logo abaixo, o da esquerda)
+int perfeitamente_balanceada(no_t *raiz) {
+    pilha_vetor_t *pilha, *ordem;
+    int *tamanhos, n = 0, ok = 1;
+
+    if (raiz == NULL)
+        return 1;
+    pilha = pegar_pilha();
+    ordem = pegar_pilha();
+    empilhar_vetor(pilha, raiz);
+    while (pilha->topo > 0) {
+        no_t *no = pilha->nos[--pilha->topo];
+        empilhar_vetor(ordem, no);
+        if (no->esq) empilhar_vetor(pilha, NO(no->esq));
+        if (no->dir) empilhar_vetor(pilha, NO(no->dir));
+    }
+    tamanhos = (int *)malloc(ordem->topo * sizeof(int));
+    while (ok && ordem->topo > 0) {
+        no_t *no = ordem->nos[--ordem->topo];
+        int dir = no->dir ? tamanhos[--n] : 0;
+        int esq = no->esq ? tamanhos[--n] : 0;
+
+        if (esq - dir > 1 || dir - esq > 1)
+            ok = 0;
+        tamanhos[n++] = esq + dir + 1;
+    }
+    free(tamanhos);
+    devolver_pilha(ordem);
+    devolver_pilha(pilha);
+    return ok;
+}
+
+//Número de nós, por um percurso de Morris (sem o campo tamanho)
+int contar_nos(no_t *raiz) {
+    int n = 0;
+
+    while (morris_proximo(&raiz) != NULL)
+        n++;
+    return n;
+}
+
+//Compara n inserir() com montar_de_vetor, com as chaves em ordem aleatória
+//e crescente. Inserir em ordem crescente é O(n^2) sem -DARVORE_AVL, então
+//só roda até 20000 chaves.
+int benchmark_montagem(int n) {
+    int *chaves = (int *)malloc(n * sizeof(int));
+    int *copia = (int *)malloc(n * sizeof(int));
+    int erros = 0;
+    double t0;
+
+    printf("%-10s %-16s %10s %10s %12s\n", "chaves", "montagem", "ms", "nos", "balanceada?");
+    for (int ordenadas = 0; ordenadas <= 1; ordenadas++) {
+        const char *nome = ordenadas ? "crescentes" : "aleatorias";
+        srand(1);
+        for (int i = 0; i < n; i++)
+            chaves[i] = ordenadas ? 2 * i : aleat(0, 2 * n);
+
+        if (!ordenadas || n <= 20000) {
+            no_t *arvore = NULL;
+            t0 = agora_ms();
+            for (int i = 0; i < n; i++)
+                arvore = inserir(arvore, chaves[i]);
+            printf("%-10s %-16s %10.1f %10d %12s\n", nome, "inserir", agora_ms() - t0,
+                   contar_nos(arvore), perfeitamente_balanceada(arvore) ? "sim" : "nao");
+            liberar_arvore(arvore);
+        }
+
+        int m = n;
+        memcpy(copia, chaves, n * sizeof(int));
+        t0 = agora_ms();
+        no_t *montada = montar_de_vetor(copia, &m, DESCARTAR_DUPLICADAS);
+        printf("%-10s %-16s %10.1f %10d %12s\n", nome, "montar_de_vetor", agora_ms() - t0,
+               m, perfeitamente_balanceada(montada) ? "sim" : "nao");
+        if (!perfeitamente_balanceada(montada) || contar_nos(montada) != m)
+            erros++;
+        liberar_arvore(montada);
+    }
+    free(chaves);
+    free(copia);
+    return erros != 0;
+}
+
+//Tempo para montar e liberar uma árvore balanceada de n nós e memória usada
+int benchmark_memoria(int n) {
+    double t0 = agora_ms();
+    no_t *arvore = montar_balanceada(0, n - 1);
+    printf("montar %d nos: %.1f ms\n", n, agora_ms() - t0);
+
+    t0 = agora_ms();
+    arvore = dobraArvore(arvore);
+    printf("dobraArvore: %.1f ms\n", agora_ms() - t0);
+
+#ifdef ARVORE_ARENA
+    relatorioArena(&arena_nos, stdout);
+    t0 = agora_ms();
+    liberar_todas_arvores(); // só esta árvore existe
+    printf("liberar_todas_arvores: %.1f ms\n", agora_ms() - t0);
+#else
+    printf("%d nos de %zu bytes alocados um a um com malloc\n", 2 * n, sizeof(no_t));
+    t0 = agora_ms();
+    liberar_arvore(arvore);
+    printf("liberar_arvore: %.1f ms\n", agora_ms() - t0);
+#endif
+    return 0;
+}
+
+int main(int argc, char *argv[]) {
+    // "./teste bench [n] [repeticoes]" mede as buscas em vez de rodar o exemplo
+    if (argc > 1 && strcmp(argv[1], "bench") == 0)
+        return benchmark(argc > 2 ? atoi(argv[2]) : 10000000,
+                         argc > 3 ? atoi(argv[3]) : 5);
+    // "./teste heap [n]" compara as formas de montar um heap de máximo
+    if (argc > 1 && strcmp(argv[1], "heap") == 0)
+        return benchmark_heap(argc > 2 ? atoi(argv[2]) : 1000000);
+    // "./teste eytzinger [n] [buscas]" mede a busca na árvore congelada
+    if (argc > 1 && strcmp(argv[1], "eytzinger") == 0)
+        return benchmark_eytzinger(argc > 2 ? atoi(argv[2]) : 1000000,
+                                   argc > 3 ? atoi(argv[3]) : 5000000);
+    // "./teste montagem [n]" compara inserir() com montar_de_vetor
+    if (argc > 1 && strcmp(argv[1], "montagem") == 0)
+        return benchmark_montagem(argc > 2 ? atoi(argv[2]) : 1000000);
+    // "./teste memoria [n]" mede montagem, dobraArvore e liberação
+    if (argc > 1 && strcmp(argv[1], "memoria") == 0)
+        return benchmark_memoria(argc > 2 ? atoi(argv[2]) : 10000000);
+#ifdef ARVORE_PARALELA
+    // "./teste paralelo [n] [max_threads]" mede a escalabilidade
+    if (argc > 1 && strcmp(argv[1], "paralelo") == 0)
+        return benchmark_paralelo(argc > 2 ? atoi(argv[2]) : 10000000,
+                                  argc > 3 ? atoi(argv[3]) : 32);
+#endif
+#ifdef ARVORE_AUMENTADA
+    // "./teste verifica [n] [rodadas]" confere as consultas por subárvore
+    if (argc > 1 && strcmp(argv[1], "verifica") == 0)
+        return verifica_consultas(argc > 2 ? atoi(argv[2]) : 1000,
+                                  argc > 3 ? atoi(argv[3]) : 200) != 0;
+#endif
 
-int main() {
     no_t *arvore = NULL;
     int i, n = 10; // Número de elementos na árvores
+    int chaves[10];
     
     srand(time(NULL));
     
     // Gerar árvore aleatória com 10 elementos
     printf("Inserindo elementos na árvore:\n");
     for (i = 0; i < n; i++) {
-        int chave = aleat(1, 100);
-        printf("%d ", chave);
-        arvore = inserir(arvore, chave);
+        chaves[i] = aleat(1, 100);
+        printf("%d ", chaves[i]);
     }
+    // Monta de uma vez a árvore balanceada (sem as repetidas, como inserir
+    // faria), em vez de um inserir por chave
+    arvore = montar_de_vetor(chaves, &n, DESCARTAR_DUPLICADAS);
     printf("\n\nÁrvore original (em ordem):\n");
     em_ordem(arvore);
     printf("\n");
@@ -285,6 +1631,13 @@ int main() {
     // Testar busca do menor elemento
     no_t *menor = busca_minimo(arvore);
     printf("Menor elemento na árvore: %d\n", menor ? menor->chave : -1);
+
+#ifdef ARVORE_AUMENTADA
+    // Mesmas consultas pelos campos de subárvore, sem percorrer a árvore
+    no_t *mediana = k_esimo(arvore, (arvore->tamanho + 1) / 2);
+    printf("Soma (campos da subárvore): %lld, menor: %d, mediana: %d\n",
+           soma_arvore(arvore), minimo_arvore(arvore), mediana->chave);
+#endif
     
     // Aplicar e testar paiMaior
     paiMaior(arvore);
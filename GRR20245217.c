@@ -1,5 +1,8 @@
 /*---------------------------------------------------------
 PROGRAMA: cliente TAD ArvBin
+  O ItemArv daqui é int, então a ArvBin tem que ser compilada com o
+  mesmo tipo (a padrão é char[50]):
+    gcc -DARV_ITEM_INT clienteArvBin.c tadArvBin.c tadEntradaSaida.c -o cliente_arv
 -----------------------------------------------------------*/
 
 #include <stdio.h>
@@ -82,15 +85,13 @@ Nodo *dobraArvore(Nodo *atual) {
     atual->esq = dobraArvore(atual->esq);
     atual->dir = dobraArvore(atual->dir);
 
-    // Cria um novo nó que será o pai do nó atual
-    Nodo *novoPai = (Nodo *)malloc(sizeof(Nodo));
-    if (novoPai == NULL) return NULL; // Falha na alocação
-
     // Define o valor do novo pai: se for par, soma 1; se for ímpar, subtrai 1
-    if (atual->item % 2 == 0)
-        novoPai->item = atual->item + 1;
-    else
-        novoPai->item = atual->item - 1;
+    ItemArv valor = (atual->item % 2 == 0) ? atual->item + 1 : atual->item - 1;
+
+    // Cria o novo nó que será o pai do nó atual (pelo TAD, que pode
+    // estar usando a arena de nodos)
+    Nodo *novoPai = criaNoArv(valor);
+    if (novoPai == NULL) return NULL; // Falha na alocação
 
     // Se o valor original for par, o nó atual vai para a esquerda do novo pai
     if (atual->item % 2 == 0) {
@@ -135,17 +136,39 @@ void maiorNaRaiz(Nodo *atual) {
     }
 }
 
+// Desce o valor do nó trocando-o com o do maior filho até que nenhum
+// filho seja maior (peneiramento de heap)
+void peneira(Nodo *atual) {
+    while (atual != NULL) {
+        Nodo *maior = atual;
+
+        if (atual->esq != NULL && atual->esq->item > maior->item)
+            maior = atual->esq;
+        if (atual->dir != NULL && atual->dir->item > maior->item)
+            maior = atual->dir;
+        if (maior == atual)
+            return;
+
+        int temp = atual->item;
+        atual->item = maior->item;
+        maior->item = temp;
+        atual = maior;
+    }
+}
+
+// Deixa cada pai maior que os filhos sem perder nenhum valor: primeiro as
+// subárvores viram heaps, depois o valor do nó atual desce até o lugar
+// certo. Cada nó desce no máximo a altura da sua subárvore, então o total
+// é O(n) numa árvore balanceada (antes era um maiorNaRaiz, com um paiMaior
+// completo, por nó)
 void ordenaPeloMaior(Nodo *atual) {
     if (atual == NULL) {
         return;
     }
 
-    // Primeiro, aplicamos `maiorNaRaiz` para garantir que o maior valor esteja na raiz
-    maiorNaRaiz(atual);
-
-    // Depois, aplicamos recursivamente nos filhos para propagar a ordenação na árvore
     ordenaPeloMaior(atual->esq);
     ordenaPeloMaior(atual->dir);
+    peneira(atual);
 }
 
 
@@ -154,17 +177,38 @@ void ordenaPeloMaior(Nodo *atual) {
 */
 int main(int argc, char *argv[]) {
     ArvBin arv;
-    ItemArv v;
-    
-    // Criar árvore vazia
-    criaArv(&arv);
+    ItemArv v, *valores;
+    int n = 0, capacidade = 1024;
     
-    // Ler e inserir valores até encontrar FIM
+    // Ler os valores até encontrar FIM num vetor que dobra quando enche
+    valores = malloc(capacidade * sizeof(ItemArv));
+    if (valores == NULL) {
+        fprintf(stderr, "Sem memória para os valores\n");
+        return 1;
+    }
     read(v);
     while (!eq(v, FIM)) {
-        arv = insereArv(v, arv);
+        if (n == capacidade) {
+            // em um ponteiro à parte: se o realloc falhar, valores ainda
+            // precisa ser liberado
+            ItemArv *maior = realloc(valores, 2 * capacidade * sizeof(ItemArv));
+            if (maior == NULL) {
+                fprintf(stderr, "Sem memória para %d valores\n", 2 * capacidade);
+                free(valores);
+                return 1;
+            }
+            valores = maior;
+            capacidade *= 2;
+        }
+        cp(valores[n], v);
+        n++;
         read(v);
     }
+
+    // Montar de uma vez a árvore balanceada com os valores lidos (em vez
+    // de uma insereArv por valor, que fica O(n^2) com a entrada ordenada)
+    arv = montaArv(valores, &n, MANTEM_REPETIDOS);
+    free(valores);
     
     // Exibir árvore original
     printf("\nÁrvore original:\n");
@@ -0,0 +1,31 @@
+/*---------------------------------------------------------
+Interface: TAD Arena (alocador de itens de tamanho fixo)
+  Os itens são entregues em sequência dentro de blocos que dobram de
+  tamanho, sem cabeçalho por item. Um item pode ser devolvido sozinho
+  (devolveArena: vai para uma lista de livres e é o próximo a ser
+  entregue) ou todos de uma vez, com os blocos (liberaArena).
+  Cada item também tem um índice de 32 bits (a partir de 1; 0 é
+  "nenhum") que pode substituir um ponteiro: os itens nunca mudam de
+  lugar, então o índice vale até o item ser devolvido.
+-----------------------------------------------------------*/
+#include <stdio.h>
+#include <stddef.h>
+
+#define BITS_BLOCO_ARENA 10   /* 1º bloco: 1024 itens */
+#define MAX_BLOCOS_ARENA 22   /* cada bloco tem o dobro do anterior */
+
+typedef struct Arena {
+  size_t tamItem;                   /* já arredondado para o alinhamento */
+  char *blocos[MAX_BLOCOS_ARENA];
+  unsigned int usados;              /* itens já tirados dos blocos */
+  void *livres;                     /* devolvidos, ligados pelo 1º campo */
+  unsigned int numLivres;
+} Arena;
+
+void criaArena( Arena*, size_t );
+void *alocaArena( Arena* );
+void devolveArena( Arena*, void* );
+void *itemArena( Arena*, unsigned int );
+unsigned int indiceArena( Arena*, void* );
+void liberaArena( Arena* );
+void relatorioArena( Arena*, FILE* );
@@ -1,19 +1,97 @@
 /*---------------------------------------------------------
 Interface: TAD Arvore
+  Com -DARV_AVL (compile tadArvAVL.c junto de tadArvBin.c) a árvore é
+  rebalanceada a cada inserção, e contaNoArv, alturaArv e arvCompleta
+  passam a ser O(1)
+  Com -DARV_INDICES (junto de -DARV_ARENA) os filhos são o índice de 32
+  bits do nodo na arena (0 é "nenhum") em vez de um ponteiro de 64
+  bits; quem mexe em esq e dir lê com NODO() e grava com LIGA(), que
+  sem a flag não fazem nada
 -----------------------------------------------------------*/
+#if defined(ARV_AVL) && defined(ARV_INTERNADA)
+#error "ARV_AVL e ARV_INTERNADA não podem ser usados juntos"
+#endif
+#if defined(ARV_ITEM_INT) && defined(ARV_INTERNADA)
+#error "ARV_INTERNADA guarda textos; não combina com ARV_ITEM_INT"
+#endif
+
 typedef struct Nodo *ApNodo;
+
+#ifdef ARV_INDICES
+#ifndef ARV_ARENA
+#error "ARV_INDICES precisa de ARV_ARENA (os índices são da arena)"
+#endif
+#include "arena.h"
+extern Arena arenaArv;   /* de tadArvBin.c */
+typedef unsigned int LigaNodo;
+#define NODO(l) ((ApNodo) itemArena( &arenaArv, (l) ))
+#define LIGA(p) indiceArena( &arenaArv, (p) )
+#else
+typedef ApNodo LigaNodo;
+#define NODO(l) (l)
+#define LIGA(p) (p)
+#endif
+
 typedef struct Nodo {
+#ifdef ARV_INTERNADA
+  /* -DARV_INTERNADA (com tadTextos.c): o texto fica no reservatório
+     de textos.h e o nodo guarda só prefixo e posição (24 bytes) */
+  unsigned int prefixo;
+  unsigned int texto;
+#else
   ItemArv item;
-  ApNodo esq, dir;
+#endif
+  LigaNodo esq, dir;
+#ifdef ARV_AVL
+  int altura;   /* altura da subárvore com raiz neste nodo */
+  int tamanho;  /* quantidade de nodos dessa subárvore */
+#endif
 } Nodo;
 
 typedef ApNodo ArvBin;
 
+/* Política de montaArv para itens repetidos */
+#define DESCARTA_REPETIDOS 0
+#define MANTEM_REPETIDOS 1   /* como insereArv */
+
+/* Forma da árvore, calculada em uma única passada por formaArv */
+typedef struct FormaArv {
+  long nodos;
+  int altura;
+  int perfeita;     /* todos os níveis cheios (o que arvCompleta verifica) */
+  int completa;     /* todos os níveis cheios menos o último, que é
+                       preenchido da esquerda para a direita */
+  int cheia;        /* todo nodo tem 0 ou 2 filhos */
+  int balanceada;   /* em todo nodo as alturas dos filhos diferem de 0 ou 1 */
+  int fatorBalanceamento;  /* altura(esq) - altura(dir) na raiz */
+} FormaArv;
+
+/* Árvore congelada no layout de Eytzinger (ordem de BFS): os filhos de
+   itens[k] ficam em itens[2k] e itens[2k+1], a partir de k = 1 */
+typedef struct ArvCongelada {
+  ItemArv *itens;
+  int n;
+} ArvCongelada;
+
 void criaArv( ArvBin* );
 int arvVazia( ArvBin );
+ApNodo criaNoArv( ItemArv );
 ArvBin insereArv( ItemArv , ArvBin );
+ArvBin montaArv( ItemArv* , int* , int );
+ApNodo buscaArv( ItemArv , ArvBin );
 void escreveArv( ArvBin );
 int alturaArv( ArvBin );
 int contaNoArv( ArvBin );
 int arvCompleta( ArvBin ); 
+FormaArv formaArv( ArvBin );
 void freeArv( ArvBin );
+#ifdef ARV_ARENA
+void liberaTodasArv( void );   /* devolve a arena: libera todas as árvores */
+#endif
+void relatorioMemoriaArv( void );
+#ifndef ARV_ITEM_INT
+const char *textoNodo( ApNodo );
+#endif
+ArvCongelada congelaArv( ArvBin );
+int buscaCongelada( ItemArv , ArvCongelada* );
+void liberaCongelada( ArvCongelada* );
@@ -0,0 +1,135 @@
+/*---------------------------------------------------------
+PROGRAMA: benchmark de busca na ArvBin com inserções ordenadas
+e aleatórias
+    gcc -O2 benchArvBin.c tadArvBin.c tadEntradaSaida.c -o bench_arv -lm
+    gcc -O2 -DARV_AVL benchArvBin.c tadArvBin.c tadArvAVL.c tadEntradaSaida.c -o bench_avl -lm
+  Nodos na arena (acrescente a qualquer uma das linhas acima):
+    -DARV_ARENA tadArena.c
+  e, com os filhos ligados por índices de 32 bits na arena:
+    -DARV_ARENA -DARV_INDICES tadArena.c
+  Uso: ./bench_xxx [nodos] [buscas]
+  Mede também a busca depois de congelar a árvore (congelaArv) e a
+  montagem de uma vez pelo vetor de chaves (montaArv)
+  (na árvore sem balanceamento a inserção ordenada é O(n^2): use
+   poucos nodos)
+-----------------------------------------------------------*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+typedef char ItemArv[50];
+#include "itemString.h"
+#include "arvBin.h"
+
+/* ----------------------------------------------------- */
+/* Tempo de relógio em milissegundos */
+double agoraMs( void ){
+  struct timespec ts;
+
+  clock_gettime( CLOCK_MONOTONIC, &ts );
+  return ts.tv_sec * 1000.0 + ts.tv_nsec / 1e6;
+}
+
+/* ----------------------------------------------------- */
+/* Chave de texto com zeros à esquerda: a ordem das strings é a dos números */
+void chave( ItemArv v, int i ){
+  sprintf( v, "%09d", i );
+}
+
+/* ----------------------------------------------------- */
+/* Insere as chaves 0..n-1 na ordem de `ordem` (ou, com monta, passa o
+   vetor a montaArv), mede as buscas e libera */
+void mede( const char *nome, int *ordem, int n, int buscas, int monta ){
+  ArvBin arv;
+  ArvCongelada congelada;
+  ItemArv v, *consultas, *itens;
+  int i, m = n, achados = 0, achadosCong = 0;
+  double t0, tIns, tBusca, tCong;
+
+  criaArv( &arv );
+  if( monta ){
+    itens = (ItemArv*) malloc( n * sizeof(ItemArv) );
+    for( i = 0; i < n; i++ )
+      chave( itens[i], ordem[i] );
+    t0 = agoraMs();
+    arv = montaArv( itens, &m, DESCARTA_REPETIDOS );
+    tIns = agoraMs() - t0;
+    free( itens );
+  }
+  else {
+    t0 = agoraMs();
+    for( i = 0; i < n; i++ ){
+      chave( v, ordem[i] );
+      arv = insereArv( v, arv );
+    }
+    tIns = agoraMs() - t0;
+  }
+
+  consultas = (ItemArv*) malloc( buscas * sizeof(ItemArv) );
+  for( i = 0; i < buscas; i++ )
+    chave( consultas[i], rand() % n );
+
+  t0 = agoraMs();
+  for( i = 0; i < buscas; i++ )
+    if( buscaArv( consultas[i], arv ) != NULL )
+      achados++;
+  tBusca = agoraMs() - t0;
+
+  congelada = congelaArv( arv );
+  t0 = agoraMs();
+  for( i = 0; i < buscas; i++ )
+    achadosCong += buscaCongelada( consultas[i], &congelada );
+  tCong = agoraMs() - t0;
+
+  printf( "%-10s %9d %8d %12.1f %12.1f %12.1f%s\n", nome, n, alturaArv( arv ),
+          tIns, tBusca * 1e6 / buscas, tCong * 1e6 / buscas,
+          achados == buscas && achadosCong == buscas ? "" : "  BUSCA FALHOU" );
+  relatorioMemoriaArv();
+  liberaCongelada( &congelada );
+  free( consultas );
+  t0 = agoraMs();
+#ifdef ARV_ARENA
+  liberaTodasArv();   /* só esta árvore existe: devolve a arena inteira */
+  printf( "%-10s liberaTodasArv: %.1f ms\n", nome, agoraMs() - t0 );
+#else
+  freeArv( arv );
+  printf( "%-10s freeArv: %.1f ms\n", nome, agoraMs() - t0 );
+#endif
+}
+
+/* ----------------------------------------------------- */
+int main( int argc, char *argv[] ){
+  int n = 20000, buscas = 100000, i, j, t;
+  int *ordem;
+
+  if( argc > 1 )
+    n = atoi( argv[1] );
+  if( argc > 2 )
+    buscas = atoi( argv[2] );
+  ordem = (int*) malloc( n * sizeof(int) );
+  srand( 42 );
+
+#ifdef ARV_AVL
+  printf( "ArvBin AVL\n" );
+#else
+  printf( "ArvBin sem balanceamento\n" );
+#endif
+  printf( "%-10s %9s %8s %12s %12s %12s\n", "insercao", "nodos", "altura",
+          "ins (ms)", "busca (ns)", "congel. (ns)" );
+
+  for( i = 0; i < n; i++ )
+    ordem[i] = i;
+  mede( "ordenada", ordem, n, buscas, 0 );
+  mede( "monta ord.", ordem, n, buscas, 1 );
+
+  for( i = n - 1; i > 0; i-- ){
+    j = rand() % (i + 1);
+    t = ordem[i]; ordem[i] = ordem[j]; ordem[j] = t;
+  }
+  mede( "aleatoria", ordem, n, buscas, 0 );
+  mede( "monta alea", ordem, n, buscas, 1 );
+
+  free( ordem );
+  return 0;
+}
@@ -0,0 +1,137 @@
+/*---------------------------------------------------------
+PROGRAMA: benchmark da fila com várias threads
+  Cada thread alterna inserções e remoções na mesma fila. Compara a
+  fila em vetor protegida por mutex com as duas filas lock-free:
+    gcc -O2 -pthread benchFilaConcorrente.c tadFilaConcorrente.c tadFilaVetor.c -o bench_conc
+  Uso: ./bench_conc [operacoes por thread] [max threads]
+-----------------------------------------------------------*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <pthread.h>
+#include <time.h>
+
+typedef int ItemFila;
+#include "filaVetor.h"
+#include "filaConcorrente.h"
+
+#define CAP_LIMITADA 1024
+
+enum { MUTEX, LIMITADA, MS, NUM_VARIANTES };
+const char *nomes[NUM_VARIANTES] = { "mutex+vetor", "limitada (Vyukov)", "encadeada (M-S)" };
+
+Fila filaMutex;
+pthread_mutex_t trava = PTHREAD_MUTEX_INITIALIZER;
+FilaLimitada filaLim;
+FilaMS filaMS;
+
+int variante;
+long opsPorThread;
+pthread_barrier_t largada;
+
+/* ----------------------------------------------------- */
+/* Tempo de relógio em milissegundos */
+double agoraMs( void ){
+  struct timespec ts;
+
+  clock_gettime( CLOCK_MONOTONIC, &ts );
+  return ts.tv_sec * 1000.0 + ts.tv_nsec / 1e6;
+}
+
+/* ----------------------------------------------------- */
+/* Insere um item e remove um item, opsPorThread vezes;
+   devolve a soma dos itens removidos */
+void *trabalha( void *arg ){
+  long id = (long) arg, soma = 0, i;
+  ItemFila v;
+  int ok;
+
+  pthread_barrier_wait( &largada );
+  for( i = 0; i < opsPorThread; i++ ){
+    v = (int)( id * opsPorThread + i );
+    switch( variante ){
+    case MUTEX:
+      pthread_mutex_lock( &trava );
+      insereFila( v, &filaMutex );
+      ok = !filaVazia( filaMutex );
+      if( ok )
+        removeFila( &filaMutex, &v );
+      pthread_mutex_unlock( &trava );
+      break;
+    case LIMITADA:
+      while( !insereFilaLimitada( v, &filaLim ))
+        ;
+      ok = removeFilaLimitada( &filaLim, &v );
+      break;
+    default:
+      insereFilaMS( v, &filaMS );
+      ok = removeFilaMS( &filaMS, &v );
+    }
+    if( ok )
+      soma += v;
+  }
+  if( variante == MS )
+    encerraThreadFilaMS();
+  return (void*) soma;
+}
+
+/* ----------------------------------------------------- */
+int main( int argc, char *argv[] ){
+  int maxThreads = 8, n, t, i;
+  long ops = 1000000, soma, esperado;
+  pthread_t th[MAX_THREADS_FILA];
+  void *parcial;
+  ItemFila v;
+  double t0, ms;
+
+  if( argc > 1 )
+    ops = atol( argv[1] );
+  if( argc > 2 )
+    maxThreads = atoi( argv[2] );
+  if( maxThreads > MAX_THREADS_FILA )
+    maxThreads = MAX_THREADS_FILA;
+
+  printf( "%-20s %8s %12s %10s\n", "fila", "threads", "Mops/s", "ms" );
+  for( variante = 0; variante < NUM_VARIANTES; variante++ )
+    for( n = 1; n <= maxThreads; n *= 2 ){
+      criaFila( &filaMutex );
+      criaFilaLimitada( &filaLim, CAP_LIMITADA );
+      criaFilaMS( &filaMS );
+      opsPorThread = ops;
+      pthread_barrier_init( &largada, NULL, n );
+
+      t0 = agoraMs();
+      for( t = 0; t < n; t++ )
+        pthread_create( &th[t], NULL, trabalha, (void*)(long) t );
+      soma = 0;
+      for( t = 0; t < n; t++ ){
+        pthread_join( th[t], &parcial );
+        soma += (long) parcial;
+      }
+      ms = agoraMs() - t0;
+
+      /* o que sobrou na fila também entra na conferência */
+      while( !filaVazia( filaMutex )){
+        removeFila( &filaMutex, &v );
+        soma += v;
+      }
+      while( removeFilaLimitada( &filaLim, &v ))
+        soma += v;
+      while( removeFilaMS( &filaMS, &v ))
+        soma += v;
+      encerraThreadFilaMS();
+
+      esperado = 0;
+      for( i = 0; i < n; i++ )
+        esperado += ops * (i * ops) + ops * (ops - 1) / 2;
+      printf( "%-20s %8d %12.2f %10.1f%s\n", nomes[variante], n,
+              2.0 * n * ops / ms / 1000.0, ms,
+              soma == esperado ? "" : "  SOMA ERRADA" );
+
+      pthread_barrier_destroy( &largada );
+      liberaFila( &filaMutex );
+      liberaFilaLimitada( &filaLim );
+      liberaFilaMS( &filaMS );
+    }
+  return 0;
+}
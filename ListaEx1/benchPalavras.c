@@ -0,0 +1,88 @@
+/*---------------------------------------------------------
+PROGRAMA: benchmark da ArvBin com uma lista grande de palavras
+  Compara os nodos com o texto embutido (ItemArv de 50 bytes, strcmp
+  em cada comparação) com o modo de textos internados:
+    gcc -O2 benchPalavras.c tadArvBin.c tadEntradaSaida.c -o bench_palavras
+    gcc -O2 -DARV_INTERNADA benchPalavras.c tadArvBin.c tadEntradaSaida.c tadTextos.c -o bench_internadas
+  Uso: ./bench_xxx [palavras] [buscas]
+-----------------------------------------------------------*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+typedef char ItemArv[50];
+#include "itemString.h"
+#include "arvBin.h"
+
+/* ----------------------------------------------------- */
+/* Tempo de relógio em milissegundos */
+double agoraMs( void ){
+  struct timespec ts;
+
+  clock_gettime( CLOCK_MONOTONIC, &ts );
+  return ts.tv_sec * 1000.0 + ts.tv_nsec / 1e6;
+}
+
+/* ----------------------------------------------------- */
+/* Palavra aleatória de 4 a 12 letras minúsculas; as letras seguem
+   uma distribuição desigual, como em texto, para haver prefixos repetidos */
+void sorteiaPalavra( ItemArv v ){
+  const char *letras = "eeeeaaaaoooossrriinnddmmuuttccllppvgqbfhjxzkwy";
+  int tam = 4 + rand() % 9, i;
+
+  for( i = 0; i < tam; i++ )
+    v[i] = letras[rand() % 46];
+  v[tam] = '\0';
+}
+
+/* ----------------------------------------------------- */
+int main( int argc, char *argv[] ){
+  int n = 1000000, buscas = 1000000, i, achados = 0;
+  ItemArv *palavras, *consultas;
+  ArvBin arv;
+  double t0, tIns, tBusca;
+
+  if( argc > 1 )
+    n = atoi( argv[1] );
+  if( argc > 2 )
+    buscas = atoi( argv[2] );
+
+  srand( 3 );
+  palavras = (ItemArv*) malloc( n * sizeof(ItemArv) );
+  consultas = (ItemArv*) malloc( buscas * sizeof(ItemArv) );
+  for( i = 0; i < n; i++ )
+    sorteiaPalavra( palavras[i] );
+  /* metade das buscas por palavras inseridas, metade por novas */
+  for( i = 0; i < buscas; i++ )
+    if( i % 2 )
+      cp( consultas[i], palavras[rand() % n] );
+    else
+      sorteiaPalavra( consultas[i] );
+
+  criaArv( &arv );
+  t0 = agoraMs();
+  for( i = 0; i < n; i++ )
+    arv = insereArv( palavras[i], arv );
+  tIns = agoraMs() - t0;
+
+  t0 = agoraMs();
+  for( i = 0; i < buscas; i++ )
+    achados += buscaArv( consultas[i], arv ) != NULL;
+  tBusca = agoraMs() - t0;
+
+#ifdef ARV_INTERNADA
+  printf( "ArvBin com textos internados\n" );
+#else
+  printf( "ArvBin com texto no nodo\n" );
+#endif
+  printf( "sizeof(Nodo) = %zu, altura %d\n", sizeof(Nodo), alturaArv( arv ));
+  printf( "insercao: %.1f ms (%.0f ns/palavra)\n", tIns, tIns * 1e6 / n );
+  printf( "busca:    %.1f ms (%.0f ns/busca, %d achadas)\n", tBusca, tBusca * 1e6 / buscas, achados );
+  relatorioMemoriaArv();
+
+  freeArv( arv );
+  free( palavras );
+  free( consultas );
+  return 0;
+}
@@ -0,0 +1,126 @@
+/*---------------------------------------------------------
+PROGRAMA: benchmark dos percursos da ArvBin (iterativos x recursivos)
+em uma árvore degenerada (como a gerada por inserções ordenadas) e em
+uma árvore perfeitamente balanceada
+    gcc -O2 benchPercursoArv.c tadArvBin.c tadEntradaSaida.c -o bench_percurso -lm
+  Uso: ./bench_percurso [nodos]
+  As versões recursivas só rodam na árvore degenerada até
+  LIMITE_RECURSAO nodos, acima disso estouram a pilha de execução
+-----------------------------------------------------------*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+typedef char ItemArv[50];
+#include "itemString.h"
+#include "arvBin.h"
+
+#define LIMITE_RECURSAO 100000
+
+/* ----------------------------------------------------- */
+/* Tempo de relógio em milissegundos */
+double agoraMs( void ){
+  struct timespec ts;
+
+  clock_gettime( CLOCK_MONOTONIC, &ts );
+  return ts.tv_sec * 1000.0 + ts.tv_nsec / 1e6;
+}
+
+/* ----------------------------------------------------- */
+/* Versões recursivas originais, para comparação          */
+int contaRec( ArvBin p ){
+  if( p == NULL )
+    return 0;
+  return 1 + contaRec( p->esq ) + contaRec( p->dir );
+}
+
+int alturaRec( ArvBin p ){
+  int he, hd;
+
+  if( p == NULL )
+    return 0;
+  he = alturaRec( p->esq );
+  hd = alturaRec( p->dir );
+  return (he > hd ? he : hd) + 1;
+}
+
+void freeRec( ArvBin p ){
+  if( p != NULL ){
+    freeRec( p->esq );
+    freeRec( p->dir );
+    free( p );
+  }
+}
+
+/* ----------------------------------------------------- */
+ArvBin novoNodo( void ){
+  ArvBin p = (ArvBin) malloc( sizeof(Nodo) );
+
+  p->item[0] = '\0';
+  p->esq = p->dir = NULL;
+  return p;
+}
+
+/* Lista encadeada pela direita, igual a n inserções crescentes */
+ArvBin montaDegenerada( int n ){
+  ArvBin raiz = NULL, p;
+
+  while( n-- > 0 ){
+    p = novoNodo();
+    p->dir = raiz;
+    raiz = p;
+  }
+  return raiz;
+}
+
+/* Árvore balanceada com n nodos (recursão de profundidade log n) */
+ArvBin montaBalanceada( int n ){
+  ArvBin p;
+
+  if( n == 0 )
+    return NULL;
+  p = novoNodo();
+  p->esq = montaBalanceada( (n - 1) / 2 );
+  p->dir = montaBalanceada( n - 1 - (n - 1) / 2 );
+  return p;
+}
+
+/* ----------------------------------------------------- */
+void mede( const char *nome, int n, int degenerada ){
+  ArvBin arv;
+  double t0, tConta, tAltura, tFree;
+  int c, h, recursivo = !degenerada || n <= LIMITE_RECURSAO;
+
+  arv = degenerada ? montaDegenerada( n ) : montaBalanceada( n );
+  t0 = agoraMs(); c = contaNoArv( arv ); tConta = agoraMs() - t0;
+  t0 = agoraMs(); h = alturaArv( arv ); tAltura = agoraMs() - t0;
+  t0 = agoraMs(); freeArv( arv ); tFree = agoraMs() - t0;
+  printf( "%-12s %-10s %9d %9d %10.1f %10.1f %10.1f\n", nome, "iterativo",
+          c, h, tConta, tAltura, tFree );
+
+  if( !recursivo ){
+    printf( "%-12s %-10s (pulado: profundidade %d)\n", nome, "recursivo", n );
+    return;
+  }
+  arv = degenerada ? montaDegenerada( n ) : montaBalanceada( n );
+  t0 = agoraMs(); c = contaRec( arv ); tConta = agoraMs() - t0;
+  t0 = agoraMs(); h = alturaRec( arv ); tAltura = agoraMs() - t0;
+  t0 = agoraMs(); freeRec( arv ); tFree = agoraMs() - t0;
+  printf( "%-12s %-10s %9d %9d %10.1f %10.1f %10.1f\n", nome, "recursivo",
+          c, h, tConta, tAltura, tFree );
+}
+
+/* ----------------------------------------------------- */
+int main( int argc, char *argv[] ){
+  int n = 10000000;
+
+  if( argc > 1 )
+    n = atoi( argv[1] );
+
+  printf( "%-12s %-10s %9s %9s %10s %10s %10s\n", "arvore", "versao",
+          "nodos", "altura", "conta(ms)", "altura(ms)", "free(ms)" );
+  mede( "balanceada", n, 0 );
+  mede( "degenerada", n, 1 );
+  return 0;
+}
@@ -0,0 +1,120 @@
+/*---------------------------------------------------------
+PROGRAMA: benchmark da pilha com várias threads
+  Cada thread alterna empilha e desempilha na mesma pilha. Compara
+  a Pilha encadeada protegida por mutex com a pilha lock-free:
+    gcc -O2 -pthread benchPilhaConcorrente.c tadPilha.c tadPilhaConcorrente.c -o bench_pconc
+  Uso: ./bench_pconc [operacoes por thread] [max threads]
+-----------------------------------------------------------*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <pthread.h>
+#include <time.h>
+
+typedef int ItemPilha;
+#include "pilha.h"
+#include "pilhaConcorrente.h"
+
+#define MAX_THREADS 32
+
+Pilha pilhaMutex;
+pthread_mutex_t trava = PTHREAD_MUTEX_INITIALIZER;
+PilhaConc pilhaConc;
+
+int lockFree;
+long opsPorThread;
+pthread_barrier_t largada;
+
+/* ----------------------------------------------------- */
+/* Tempo de relógio em milissegundos */
+double agoraMs( void ){
+  struct timespec ts;
+
+  clock_gettime( CLOCK_MONOTONIC, &ts );
+  return ts.tv_sec * 1000.0 + ts.tv_nsec / 1e6;
+}
+
+/* ----------------------------------------------------- */
+/* Empilha um item e desempilha um item, opsPorThread vezes;
+   devolve a soma dos itens desempilhados */
+void *trabalha( void *arg ){
+  long id = (long) arg, soma = 0, i;
+  ItemPilha v;
+  int ok;
+
+  pthread_barrier_wait( &largada );
+  for( i = 0; i < opsPorThread; i++ ){
+    v = (int)( id * opsPorThread + i );
+    if( lockFree ){
+      empilhaConc( v, &pilhaConc );
+      ok = desempilhaConc( &pilhaConc, &v );
+    }
+    else {
+      pthread_mutex_lock( &trava );
+      empilha( v, &pilhaMutex );
+      ok = !pilhaVazia( pilhaMutex );
+      if( ok )
+        desempilha( &pilhaMutex, &v );
+      pthread_mutex_unlock( &trava );
+    }
+    if( ok )
+      soma += v;
+  }
+  liberaNosLivresPilha();   /* nodos que esta thread guardou para reaproveitar */
+  return (void*) soma;
+}
+
+/* ----------------------------------------------------- */
+int main( int argc, char *argv[] ){
+  int maxThreads = MAX_THREADS, n, t, i;
+  long ops = 1000000, soma, esperado;
+  pthread_t th[MAX_THREADS];
+  void *parcial;
+  ItemPilha v;
+  double t0, ms;
+
+  if( argc > 1 )
+    ops = atol( argv[1] );
+  if( argc > 2 )
+    maxThreads = atoi( argv[2] );
+  if( maxThreads > MAX_THREADS )
+    maxThreads = MAX_THREADS;
+
+  printf( "%-12s %8s %12s %10s\n", "pilha", "threads", "Mops/s", "ms" );
+  for( lockFree = 0; lockFree <= 1; lockFree++ )
+    for( n = 1; n <= maxThreads; n *= 2 ){
+      criaPilha( &pilhaMutex );
+      criaPilhaConc( &pilhaConc );
+      opsPorThread = ops;
+      pthread_barrier_init( &largada, NULL, n );
+
+      t0 = agoraMs();
+      for( t = 0; t < n; t++ )
+        pthread_create( &th[t], NULL, trabalha, (void*)(long) t );
+      soma = 0;
+      for( t = 0; t < n; t++ ){
+        pthread_join( th[t], &parcial );
+        soma += (long) parcial;
+      }
+      ms = agoraMs() - t0;
+
+      /* o que sobrou na pilha também entra na conferência */
+      while( !pilhaVazia( pilhaMutex )){
+        desempilha( &pilhaMutex, &v );
+        soma += v;
+      }
+      while( desempilhaConc( &pilhaConc, &v ))
+        soma += v;
+
+      esperado = 0;
+      for( i = 0; i < n; i++ )
+        esperado += ops * (i * ops) + ops * (ops - 1) / 2;
+      printf( "%-12s %8d %12.2f %10.1f%s\n", lockFree ? "lock-free" : "mutex", n,
+              2.0 * n * ops / ms / 1000.0, ms,
+              soma == esperado ? "" : "  SOMA ERRADA" );
+
+      pthread_barrier_destroy( &largada );
+      liberaPilhaConc( &pilhaConc );
+    }
+  return 0;
+}
@@ -0,0 +1,92 @@
+/*---------------------------------------------------------
+PROGRAMA: benchmark de empilha/desempilha e insere/remove
+  Compare o reaproveitamento de nodos com o malloc puro:
+    gcc -O2 benchPilhaFila.c tadPilha.c tadFila.c -o bench_pool
+    gcc -O2 -DRETENCAO_NOS=0 benchPilhaFila.c tadPilha.c tadFila.c -o bench_malloc
+  Fila em vetor circular no lugar da encadeada:
+    gcc -O2 -DFILA_VETOR benchPilhaFila.c tadPilha.c tadFilaVetor.c -o bench_vetor
+  Uso: ./bench_xxx [operacoes] [profundidade]
+-----------------------------------------------------------*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+typedef int ItemPilha;
+#include "pilha.h"
+#ifdef FILA_VETOR
+typedef int ItemFila;
+#include "filaVetor.h"
+#else
+typedef float ItemFila;
+#include "fila.h"
+#endif
+
+/* ----------------------------------------------------- */
+/* Tempo de relógio em milissegundos */
+double agoraMs( void ){
+  struct timespec ts;
+
+  clock_gettime( CLOCK_MONOTONIC, &ts );
+  return ts.tv_sec * 1000.0 + ts.tv_nsec / 1e6;
+}
+
+/* ----------------------------------------------------- 
+  Programa: alterna rajadas de inserções e remoções, mantendo no máximo
+  `profundidade` elementos na estrutura
+*/
+int main(int argc, char *argv[]){
+  long ops = (argc > 1) ? atol( argv[1] ) : 20000000;
+  int prof = (argc > 2) ? atoi( argv[2] ) : 1000;
+  Pilha pilha;
+  Fila fila;
+  ItemPilha vp;
+  ItemFila vf;
+  double inicio, soma = 0;
+  long i;
+  int j;
+
+  criaPilha( &pilha );
+  inicio = agoraMs();
+  for( i = 0; i < ops; i += 2*prof ){
+    for( j = 0; j < prof; j++ )
+      empilha( j, &pilha );
+    for( j = 0; j < prof; j++ ){
+      desempilha( &pilha, &vp );
+      soma += vp;
+    }
+  }
+  printf( "Pilha: %ld operacoes em %.2f ms\n", ops, agoraMs() - inicio );
+
+  criaFila( &fila );
+  inicio = agoraMs();
+  for( i = 0; i < ops; i += 2*prof ){
+    for( j = 0; j < prof; j++ )
+      insereFila( j, &fila );
+    for( j = 0; j < prof; j++ ){
+      removeFila( &fila, &vf );
+      soma += vf;
+    }
+  }
+  printf( "Fila : %ld operacoes em %.2f ms\n", ops, agoraMs() - inicio );
+
+#ifdef FILA_VETOR
+  /* Mesma carga em lotes */
+  ItemFila *lote = (ItemFila*) malloc( prof * sizeof(ItemFila) );
+  for( j = 0; j < prof; j++ )
+    lote[j] = j;
+  inicio = agoraMs();
+  for( i = 0; i < ops; i += 2*prof ){
+    insereFilaLote( lote, prof, &fila );
+    removeFilaLote( &fila, lote, prof );
+  }
+  printf( "Fila (lotes): %ld operacoes em %.2f ms\n", ops, agoraMs() - inicio );
+  free( lote );
+  liberaFila( &fila );
+#else
+  liberaNosLivresFila();
+#endif
+  liberaNosLivresPilha();
+  printf( "(soma de controle: %.0f)\n", soma );
+  return 0;
+}
@@ -7,7 +7,7 @@ PROGRAMA: cliente TAD Fila
 
 typedef int ItemFila;
 #include "itemInt.h"
-#include "fila.h"
+#include "filaVetor.h"
 
 /* ----------------------------------------------------- 
   Programa: cria uma fila e escreve os seus valores
@@ -28,6 +28,7 @@ int main(int argc, char *argv[]){
     write( v );
     printf("\n");
   }
+  liberaFila( &fila );
   return 0;
 }
 
@@ -28,6 +28,7 @@ int main(int argc, char *argv[]){
     write( v );
     printf("\n");
   }
+  liberaPilha( &pilha );
   return 0;
 }
 
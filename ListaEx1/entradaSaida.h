@@ -0,0 +1,25 @@
+/*---------------------------------------------------------
+Interface: TAD EntradaSaida (leitura e escrita com buffer)
+  Usada pelos macros read/write de itemInt.h, itemFloat.h e
+  itemString.h no lugar de scanf/printf. A entrada padrão é lida
+  em blocos grandes com read(2), ou mapeada inteira com mmap quando
+  é um arquivo, e os números são convertidos sem scanf. A saída
+  continua sendo stdout (então pode ser misturada com printf), mas
+  com um buffer grande quando não é um terminal.
+  Compile junto com tadEntradaSaida.c.
+-----------------------------------------------------------*/
+
+/* Como scanf: 1 se leu o valor, 0 se a entrada não tinha o formato
+   esperado e EOF no fim da entrada. Na falha, o que foi lido até ela
+   fica consumido (os espaços, o sinal, o ponto); em leFloat, uma
+   palavra que não começa com dígito, ponto ou sinal seguido deles é
+   consumida inteira (é a que seria inf ou nan) */
+int leInt( int* );
+int leFloat( float* );
+int leTexto( char*, int );   /* palavra de até tam-1 caracteres; o
+                                resto de uma palavra maior é descartado */
+
+/* Mesma saída de printf com "%d", "%f" e "%s" */
+void escreveInt( int );
+void escreveFloat( float );
+void escreveTexto( const char* );
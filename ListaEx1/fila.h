@@ -15,3 +15,4 @@ void criaFila( Fila* );
 int filaVazia( Fila );
 void insereFila( ItemFila, Fila*);
 void removeFila( Fila*, ItemFila* );
+void liberaNosLivresFila( void );
@@ -0,0 +1,50 @@
+/*---------------------------------------------------------
+Interface: TAD Fila concorrente (lock-free, vários produtores e
+consumidores)
+  FilaLimitada: vetor circular de capacidade fixa (algoritmo de Vyukov)
+  FilaMS: lista encadeada sem limite (Michael-Scott), com liberação
+          segura dos nodos por hazard pointers
+  Compilar com -pthread. Cada thread usa um dos MAX_THREADS_FILA slots
+  de hazard pointers enquanto opera em FilaMS e deve chamar
+  encerraThreadFilaMS() antes de terminar.
+-----------------------------------------------------------*/
+#include <stdatomic.h>
+#include <stddef.h>
+
+#define MAX_THREADS_FILA 128
+#define LINHA_CACHE_FILA 64
+
+typedef struct CelulaFila {
+  _Atomic size_t seq;   /* em que volta do vetor a célula está livre/ocupada */
+  ItemFila item;
+} CelulaFila;
+
+typedef struct FilaLimitada {
+  CelulaFila *celulas;
+  size_t mascara;       /* capacidade - 1 (capacidade potência de 2) */
+  _Alignas(LINHA_CACHE_FILA) _Atomic size_t ini;  /* próxima remoção */
+  _Alignas(LINHA_CACHE_FILA) _Atomic size_t fim;  /* próxima inserção */
+} FilaLimitada;
+
+typedef struct NoFilaMS *ApNoFilaMS;
+typedef struct NoFilaMS {
+  ItemFila item;
+  _Atomic(ApNoFilaMS) prox;
+} NoFilaMS;
+
+typedef struct FilaMS {
+  _Alignas(LINHA_CACHE_FILA) _Atomic(ApNoFilaMS) prim;  /* sentinela */
+  _Alignas(LINHA_CACHE_FILA) _Atomic(ApNoFilaMS) ult;
+} FilaMS;
+
+int criaFilaLimitada( FilaLimitada*, int );
+int insereFilaLimitada( ItemFila, FilaLimitada* );
+int removeFilaLimitada( FilaLimitada*, ItemFila* );
+void liberaFilaLimitada( FilaLimitada* );
+
+void criaFilaMS( FilaMS* );
+int filaVaziaMS( FilaMS* );
+void insereFilaMS( ItemFila, FilaMS* );
+int removeFilaMS( FilaMS*, ItemFila* );
+void liberaFilaMS( FilaMS* );
+void encerraThreadFilaMS( void );
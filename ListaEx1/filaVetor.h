@@ -0,0 +1,19 @@
+/*---------------------------------------------------------
+Interface: TAD Fila (vetor circular)
+-----------------------------------------------------------*/
+#define FILA_CAP_INICIAL 16  /* potência de 2 */
+
+typedef struct Fila{
+  ItemFila *item;   /* vetor circular; a capacidade é sempre potência de 2 */
+  int cap;          /* capacidade do vetor */
+  int prim;         /* posição do primeiro item */
+  int tam;          /* quantidade de itens na fila */
+} Fila;
+
+void criaFila( Fila* );
+int filaVazia( Fila );
+void insereFila( ItemFila, Fila*);
+void removeFila( Fila*, ItemFila* );
+void insereFilaLote( ItemFila*, int, Fila* );
+int removeFilaLote( Fila*, ItemFila*, int );
+void liberaFila( Fila* );
@@ -1,6 +1,7 @@
 /* ----------------------------------------------------------
 Definições e macros para tratamento do TipoItem float
 */
+#include "entradaSaida.h"
 
 typedef float Item;
 
@@ -13,5 +14,5 @@ typedef float Item;
 #define geq(A, B) (A >= B)
 #define leq(A, B) (A <= B)
 #define cp(A, B)  (A=B)
-#define read(A)   (scanf("%f", &A))
-#define write(A)  (printf("%f", A))
+#define read(A)   (leFloat(&A))
+#define write(A)  (escreveFloat(A))
@@ -1,6 +1,7 @@
 /* ----------------------------------------------------------
 Definições e macros para tratamento do TipoItem int
 */
+#include "entradaSaida.h"
 
 typedef int Item;
 
@@ -13,5 +14,5 @@ typedef int Item;
 #define geq(A, B) (A >= B)
 #define leq(A, B) (A <= B)
 #define cp(A, B)  (A= B)
-#define read(A)   (scanf("%d", &A))
-#define write(A)  (printf("%d", A))
+#define read(A)   (leInt(&A))
+#define write(A)  (escreveInt(A))
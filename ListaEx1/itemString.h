@@ -2,6 +2,7 @@
 Definições e macros para tratamento do TipoItem char*
 */
 #include <string.h>
+#include "entradaSaida.h"
 
 #define TAM 50
 
@@ -16,6 +17,6 @@ typedef char Item[TAM];
 #define geq(A, B) (strcmp(A, B) >= 0)
 #define leq(A, B) (strcmp(A, B) <= 0)
 #define cp(A, B)  (strcpy(A, B))
-#define read(A)   (scanf("%s", A))
-#define write(A)  (printf("%s", A))
+#define read(A)   (leTexto(A, TAM))
+#define write(A)  (escreveTexto(A))
 
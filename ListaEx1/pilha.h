@@ -13,3 +13,4 @@ void criaPilha( Pilha* );
 int pilhaVazia( Pilha );
 void empilha( ItemPilha, Pilha*);
 void desempilha( Pilha*, ItemPilha* );
+void liberaNosLivresPilha( void );
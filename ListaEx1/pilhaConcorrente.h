@@ -0,0 +1,40 @@
+/*---------------------------------------------------------
+Interface: TAD Pilha concorrente (lock-free, pilha de Treiber)
+  Os nodos vêm de um reservatório próprio da pilha e são
+  referenciados por índices de 32 bits; topo e lista de livres
+  guardam índice + contador de versão em 64 bits, o que impede o
+  problema ABA no CAS. Sob disputa, empilha e desempilha tentam se
+  encontrar em um vetor de eliminação e trocar o item diretamente,
+  sem passar pelo topo. Compilar com -pthread.
+-----------------------------------------------------------*/
+#include <stdatomic.h>
+#include <stdint.h>
+
+#define LINHA_CACHE_PILHA 64
+#define BITS_BLOCO_INICIAL 10     /* 1º bloco do reservatório: 1024 nodos */
+#define MAX_BLOCOS_PILHA 22       /* cada bloco tem o dobro do anterior */
+#define TAM_ELIMINACAO 16
+#define ESPERA_ELIMINACAO 128     /* iterações esperando um par */
+
+typedef struct NoPilhaConc {
+  ItemPilha item;
+  _Atomic uint32_t prox;   /* índice do próximo (0 = nenhum) */
+} NoPilhaConc;
+
+typedef struct SlotEliminacao {
+  _Alignas(LINHA_CACHE_PILHA) _Atomic uint64_t oferta;  /* versão | índice */
+} SlotEliminacao;
+
+typedef struct PilhaConc {
+  _Alignas(LINHA_CACHE_PILHA) _Atomic uint64_t topo;     /* versão | índice */
+  _Alignas(LINHA_CACHE_PILHA) _Atomic uint64_t livres;   /* versão | índice */
+  _Alignas(LINHA_CACHE_PILHA) _Atomic uint32_t proxIndice;
+  _Atomic(NoPilhaConc*) blocos[MAX_BLOCOS_PILHA];
+  SlotEliminacao eliminacao[TAM_ELIMINACAO];
+} PilhaConc;
+
+void criaPilhaConc( PilhaConc* );
+int pilhaVaziaConc( PilhaConc* );
+int empilhaConc( ItemPilha, PilhaConc* );
+int desempilhaConc( PilhaConc*, ItemPilha* );
+void liberaPilhaConc( PilhaConc* );
@@ -1,10 +1,11 @@
 /*---------------------------------------------------------
-Interface: TAD Pilha
+Interface: TAD Pilha (vetor que cresce sob demanda)
 -----------------------------------------------------------*/
-#define MAX 100
+#define PILHA_CAP_INICIAL 16
 
 struct NoPilha {
-  ItemPilha item[MAX];
+  ItemPilha *item;  /* vetor com os itens; item[topo] é o topo */
+  int cap;          /* capacidade atual do vetor */
   int topo;
 };
 
@@ -14,3 +15,6 @@ void criaPilha(Pilha*);
 int pilhaVazia( Pilha );
 void empilha( ItemPilha, Pilha*);
 void desempilha( Pilha*, ItemPilha* );
+void empilhaLote( ItemPilha*, int, Pilha* );
+int desempilhaLote( Pilha*, ItemPilha*, int );
+void liberaPilha( Pilha* );
@@ -0,0 +1,150 @@
+/*---------------------------------------------------------
+IMPLEMENTAÇÃO: TAD Arena
+-----------------------------------------------------------*/
+#include <stdio.h>
+#include <stdlib.h>
+#include "arena.h"
+
+#define ALINHAMENTO_ARENA sizeof(void*)   /* também o mínimo de um item,
+                                            que guarda o elo da lista de livres */
+
+/* ----------------------------------------------------- 
+   Quantidade de itens do bloco k
+*/
+size_t capBlocoArena( int k ){
+  return (size_t) 1 << (k + BITS_BLOCO_ARENA);
+}
+
+/* ----------------------------------------------------- 
+   Bloco e posição dentro do bloco do i-ésimo item tirado dos blocos
+   (i >= 1, que é também o índice do item): o bloco k guarda os itens
+   [B*(2^k - 1) + 1, B*(2^(k+1) - 1)], com B = 2^BITS_BLOCO_ARENA
+*/
+int blocoArena( unsigned int i, size_t *pos ){
+  unsigned long long j = (unsigned long long) i - 1 + (1u << BITS_BLOCO_ARENA);
+  int k = 63 - __builtin_clzll( j ) - BITS_BLOCO_ARENA;
+
+  *pos = j - capBlocoArena( k );
+  return k;
+}
+
+/* ----------------------------------------------------- */
+/* Arena vazia para itens de tam bytes                    */
+void criaArena( Arena *a, size_t tam ){
+  int k;
+
+  if( tam == 0 )
+    tam = 1;
+  a->tamItem = (tam + ALINHAMENTO_ARENA - 1) / ALINHAMENTO_ARENA * ALINHAMENTO_ARENA;
+  for( k = 0; k < MAX_BLOCOS_ARENA; k++ )
+    a->blocos[k] = NULL;
+  a->usados = 0;
+  a->livres = NULL;
+  a->numLivres = 0;
+}
+
+/* ----------------------------------------------------- 
+   Entrega um item (conteúdo indefinido): o último devolvido, se
+   houver, senão o próximo do bloco atual, alocando um novo bloco
+   quando ele acaba; retorna NULL se faltar memória
+*/
+void *alocaArena( Arena *a ){
+  void *p = a->livres;
+  size_t pos;
+  int k;
+
+  if( p != NULL ){
+    a->livres = *(void**) p;
+    a->numLivres--;
+    return p;
+  }
+  k = blocoArena( a->usados + 1, &pos );
+  if( k >= MAX_BLOCOS_ARENA )
+    return NULL;
+  if( a->blocos[k] == NULL ){
+    a->blocos[k] = (char*) malloc( capBlocoArena( k ) * a->tamItem );
+    if( a->blocos[k] == NULL )
+      return NULL;
+  }
+  a->usados++;
+  return a->blocos[k] + pos * a->tamItem;
+}
+
+/* ----------------------------------------------------- 
+   Devolve o item p (entregue por alocaArena) para ser reaproveitado;
+   a memória só volta ao sistema com liberaArena
+*/
+void devolveArena( Arena *a, void *p ){
+  *(void**) p = a->livres;
+  a->livres = p;
+  a->numLivres++;
+}
+
+/* ----------------------------------------------------- */
+/* Item de índice i (1 <= i <= usados) ou NULL se i == 0  */
+void *itemArena( Arena *a, unsigned int i ){
+  size_t pos;
+  int k;
+
+  if( i == 0 )
+    return NULL;
+  k = blocoArena( i, &pos );
+  return a->blocos[k] + pos * a->tamItem;
+}
+
+/* ----------------------------------------------------- 
+   Índice do item apontado por p, ou 0 se p for NULL ou não pertencer
+   à arena. Procura a partir do bloco mais novo (o do último item tirado
+   dos blocos): como cada bloco tem o dobro do anterior, metade dos
+   itens está nele
+*/
+unsigned int indiceArena( Arena *a, void *p ){
+  char *c = (char*) p;
+  size_t pos;
+  int k;
+
+  if( p == NULL || a->usados == 0 )
+    return 0;
+  for( k = blocoArena( a->usados, &pos ); k >= 0; k-- )
+    if( c >= a->blocos[k] && c < a->blocos[k] + capBlocoArena( k ) * a->tamItem )
+      return (unsigned int)( capBlocoArena( k ) - (1u << BITS_BLOCO_ARENA)
+                             + (c - a->blocos[k]) / a->tamItem + 1 );
+  return 0;
+}
+
+/* ----------------------------------------------------- */
+/* Devolve todos os itens de uma vez                      */
+void liberaArena( Arena *a ){
+  int k;
+
+  for( k = 0; k < MAX_BLOCOS_ARENA; k++ ){
+    free( a->blocos[k] );
+    a->blocos[k] = NULL;
+  }
+  a->usados = 0;
+  a->livres = NULL;
+  a->numLivres = 0;
+}
+
+/* ----------------------------------------------------- 
+   Imprime itens em uso, memória reservada pelos blocos e quanto o
+   mesmo número de itens custaria com um malloc por item (estimado
+   como o bloco do glibc: tamanho + 8 arredondado para 16, mínimo 32)
+*/
+void relatorioArena( Arena *a, FILE *saida ){
+  size_t reservado = 0, porMalloc;
+  unsigned int emUso = a->usados - a->numLivres;
+  int k;
+
+  for( k = 0; k < MAX_BLOCOS_ARENA && a->blocos[k] != NULL; k++ )
+    reservado += capBlocoArena( k ) * a->tamItem;
+  porMalloc = (a->tamItem + 8 + 15) / 16 * 16;
+  if( porMalloc < 32 )
+    porMalloc = 32;
+  porMalloc *= emUso;
+
+  fprintf( saida, "arena: %u itens de %zu bytes, %zu bytes em uso, %zu reservados "
+           "(%.1f%%), %zu com malloc por item\n",
+           emUso, a->tamItem, emUso * a->tamItem, reservado,
+           reservado ? 100.0 * emUso * a->tamItem / reservado : 0.0, porMalloc );
+}
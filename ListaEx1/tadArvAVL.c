@@ -0,0 +1,98 @@
+/*---------------------------------------------------------
+Implementação: TAD Árvore AVL
+  Só a inserção com rebalanceamento; o resto do TAD é o de
+  tadArvBin.c, compilado junto com -DARV_AVL. Cada nodo guarda a
+  altura e o tamanho da sua subárvore; depois de uma inserção os
+  nodos do caminho com fator de balanceamento +-2 são corrigidos com
+  rotações, de modo que a altura fica sempre O(log n)
+-----------------------------------------------------------*/
+#include <stdio.h>
+#include <stdlib.h>
+
+#ifdef ARV_ITEM_INT
+typedef int ItemArv;
+#include "itemInt.h"
+#else
+typedef char ItemArv[50];
+#include "itemString.h"
+#endif
+#include "arvBin.h"
+
+#ifndef ARV_AVL
+#error "tadArvAVL.c precisa de -DARV_AVL (e de tadArvBin.c)"
+#endif
+
+/* ----------------------------------------------------- */
+/* Recalcula altura e tamanho de p a partir dos filhos   */
+void atualizaAltura( ArvBin p ){
+  ArvBin e = NODO( p->esq ), d = NODO( p->dir );
+  int he = alturaArv( e ), hd = alturaArv( d );
+
+  p->altura = (he > hd ? he : hd) + 1;
+  p->tamanho = contaNoArv( e ) + contaNoArv( d ) + 1;
+}
+
+/* -----------------------------------------------------
+   Rotações simples; retornam a nova raiz da subárvore
+        p                q
+       / \              / \
+      q   c    <==>    a   p
+     / \                  / \
+    a   b                b   c
+*/
+ArvBin rotacionaDir( ArvBin p ){
+  ArvBin q = NODO( p->esq );
+
+  p->esq = q->dir;
+  q->dir = LIGA( p );
+  atualizaAltura( p );
+  atualizaAltura( q );
+  return q;
+}
+
+ArvBin rotacionaEsq( ArvBin q ){
+  ArvBin p = NODO( q->dir );
+
+  q->dir = p->esq;
+  p->esq = LIGA( q );
+  atualizaAltura( q );
+  atualizaAltura( p );
+  return p;
+}
+
+/* -----------------------------------------------------
+   Corrige o fator de balanceamento de p (entre -2 e 2) e
+   retorna a nova raiz da subárvore
+*/
+ArvBin balanceia( ArvBin p ){
+  ArvBin e = NODO( p->esq ), d = NODO( p->dir );
+  int fator;
+
+  atualizaAltura( p );
+  fator = alturaArv( e ) - alturaArv( d );
+  if( fator > 1 ){
+    if( alturaArv( NODO( e->esq )) < alturaArv( NODO( e->dir )))
+      p->esq = LIGA( rotacionaEsq( e ));   /* caso esquerda-direita */
+    return rotacionaDir( p );
+  }
+  if( fator < -1 ){
+    if( alturaArv( NODO( d->dir )) < alturaArv( NODO( d->esq )))
+      p->dir = LIGA( rotacionaDir( d ));   /* caso direita-esquerda */
+    return rotacionaEsq( p );
+  }
+  return p;
+}
+
+/* -----------------------------------------------------
+   Insere um novo Item na árvore e retorna a nova raiz
+   (a recursão tem a profundidade da árvore, O(log n))
+*/
+ArvBin insereArv( ItemArv v, ArvBin arv ){
+  if( arvVazia( arv ))
+    return criaNoArv( v );
+  if( leq(v, arv->item ))
+    arv->esq= LIGA( insereArv( v, NODO( arv->esq )));
+  else
+    arv->dir= LIGA( insereArv( v, NODO( arv->dir )));
+  return balanceia( arv );
+}
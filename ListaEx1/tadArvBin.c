@@ -1,13 +1,97 @@
 /*---------------------------------------------------------
 Implementação: TAD Árvore
+  Com -DARV_AVL a inserção vem de tadArvAVL.c; o resto é este arquivo
+  O ItemArv é texto (char[50]); -DARV_ITEM_INT troca por int, e o
+  cliente tem que declarar o mesmo tipo
 -----------------------------------------------------------*/
 #include <stdio.h>
 #include <stdlib.h>
-#include <math.h>
 
+#ifdef ARV_ITEM_INT
+typedef int ItemArv;
+#include "itemInt.h"
+#else
 typedef char ItemArv[50];
 #include "itemString.h"
+#endif
 #include "arvBin.h"
+#ifdef ARV_INTERNADA
+#include "textos.h"
+#endif
+#ifdef ARV_AVL
+void atualizaAltura( ArvBin );   /* de tadArvAVL.c */
+#endif
+
+#ifdef ARV_ARENA
+/* Com -DARV_ARENA os nodos vêm de uma arena única (sem cabeçalho de
+   malloc por nodo): freeArv devolve à arena só os nodos da árvore
+   dada, e liberaTodasArv devolve a arena inteira de uma vez */
+#ifndef ARV_INDICES
+#include "arena.h"   /* com ARV_INDICES já veio de arvBin.h */
+#endif
+
+Arena arenaArv;
+int arenaArvCriada = 0;
+#endif
+
+/* Árvores montadas por montaArv ocupam um único bloco de nodos (com
+   ARV_ARENA vêm da arena, como os demais); freeArv devolve o bloco
+   quando o último nodo dele é liberado */
+#define MAX_BLOCOS_ARV 64
+
+typedef struct BlocoNodos {
+  Nodo *nodos;
+  int n;
+  int vivos;   /* nodos do bloco ainda não liberados */
+} BlocoNodos;
+
+BlocoNodos blocosArv[MAX_BLOCOS_ARV];
+int numBlocosArv = 0;
+
+/* ----------------------------------------------------- */
+/* Libera um nodo, que pode ser de um bloco de montaArv   */
+/* (com ARV_ARENA, devolve-o à arena)                     */
+void liberaNodo( ApNodo p ){
+  int i;
+
+  for( i = 0; i < numBlocosArv; i++ )
+    if( p >= blocosArv[i].nodos && p < blocosArv[i].nodos + blocosArv[i].n ){
+      if( --blocosArv[i].vivos == 0 ){
+        free( blocosArv[i].nodos );
+        blocosArv[i] = blocosArv[--numBlocosArv];
+      }
+      return;
+    }
+#ifdef ARV_ARENA
+  devolveArena( &arenaArv, p );
+#else
+  free( p );
+#endif
+}
+
+/* ----------------------------------------------------- 
+   Pilha de nodos em vetor que dobra de tamanho, usada pelos
+   percursos iterativos (a recursão estoura a pilha de execução em
+   árvores degeneradas com milhões de nodos)
+*/
+typedef struct PilhaNodos {
+  ApNodo *nodos;
+  int topo, cap;
+} PilhaNodos;
+
+void criaPilhaNodos( PilhaNodos *s ){
+  s->cap = 64;
+  s->topo = 0;
+  s->nodos = (ApNodo*) malloc( s->cap * sizeof(ApNodo) );
+}
+
+void empilhaNodo( PilhaNodos *s, ApNodo p ){
+  if( s->topo == s->cap ){
+    s->cap *= 2;
+    s->nodos = (ApNodo*) realloc( s->nodos, s->cap * sizeof(ApNodo) );
+  }
+  s->nodos[s->topo++] = p;
+}
 
 /* ----------------------------------------------------- */
 /* Impressão da árvore */
@@ -28,14 +112,43 @@ void escreveNodoExterno( int h ){
   printf( "*\n" );
 }
 
+/* -----------------------------------------------------
+   Escreve a subárvore p, com a raiz no nível h: primeiro a direita,
+   depois o nodo e a esquerda (em ordem reversa), com pilha explícita.
+   A pilha guarda os nodos cuja direita já foi escrita e os níveis
+   ficam em um vetor paralelo
+*/
 void escreveNodo( ArvBin p, int h ){
-  if( p == NULL ){
+  PilhaNodos s;
+  int *niveis, capNiveis;
+
+  criaPilhaNodos( &s );
+  capNiveis = s.cap;
+  niveis = (int*) malloc( capNiveis * sizeof(int) );
+  for( ;; ){
+    for( ; p != NULL; p = NODO( p->dir ), h++ ){
+      empilhaNodo( &s, p );
+      if( s.cap != capNiveis ){
+        capNiveis = s.cap;
+        niveis = (int*) realloc( niveis, capNiveis * sizeof(int) );
+      }
+      niveis[s.topo - 1] = h;
+    }
     escreveNodoExterno( h );
-    return;
+    if( s.topo == 0 )
+      break;
+    p = s.nodos[--s.topo];
+    h = niveis[s.topo];
+#ifdef ARV_INTERNADA
+    escreveNodoInterno( (char*) textoNodo( p ), h );
+#else
+    escreveNodoInterno( p->item, h );
+#endif
+    p = NODO( p->esq );
+    h++;
   }
-  escreveNodo( p->dir, h+1 );
-  escreveNodoInterno( p->item, h );
-  escreveNodo( p->esq, h+1 );
+  free( niveis );
+  free( s.nodos );
 }
 
 void escreveArv( ArvBin arv ){
@@ -54,27 +167,96 @@ int arvVazia(ArvBin arv){
   return (arv == NULL);
 }
 
+#ifdef ARV_AVL
 /* ----------------------------------------------------- */
-/* Retorna a quantidade de nodos internos na arvore      */
+/* Retorna a quantidade de nodos internos na arvore (guardada no nodo) */
 int contaNoArv( ArvBin p ){
     if( p == NULL )
         return 0;
-    return 1 + contaNoArv( p-> esq ) + contaNoArv( p->dir );
+    return p->tamanho;
 }
 
 /* ----------------------------------------------------- */
-/* Retorna a altura da arvore com raiz em p */
+/* Retorna a altura da arvore com raiz em p (guardada no nodo) */
 int alturaArv( ArvBin p ){
-    int he, hd;
-
     if( p == NULL )
         return 0;
-    he= alturaArv( p-> esq );
-    hd= alturaArv( p->dir );
-    if( he > hd )
-        return he+1;
-    else
-        return hd+1;
+    return p->altura;
+}
+
+/* ----------------------------------------------------- 
+   Verifica se a árvore está completa
+*/
+int arvCompleta( ArvBin arv ){
+  int h = alturaArv( arv );
+
+  return h < 31 && contaNoArv( arv ) == (1 << h) - 1;
+}
+#else
+/* ----------------------------------------------------- 
+   Retorna a quantidade de nodos internos na arvore
+   Percurso de Morris: cada nodo com filho esquerdo é visitado duas
+   vezes, usando temporariamente o ponteiro dir do seu antecessor em
+   ordem para voltar a ele; a árvore é restaurada no fim e o espaço
+   extra é O(1)
+*/
+int contaNoArv( ArvBin p ){
+    ApNodo ant;
+    int n = 0;
+
+    while( p != NULL ){
+        if( NODO( p->esq ) == NULL ){
+            n++;
+            p = NODO( p->dir );
+            continue;
+        }
+        ant = NODO( p->esq );
+        while( NODO( ant->dir ) != NULL && NODO( ant->dir ) != p )
+            ant = NODO( ant->dir );
+        if( NODO( ant->dir ) == NULL ){
+            ant->dir = LIGA( p );       /* caminho de volta */
+            p = NODO( p->esq );
+        }
+        else {
+            ant->dir = LIGA( NULL );    /* subárvore esquerda terminada */
+            n++;
+            p = NODO( p->dir );
+        }
+    }
+    return n;
+}
+
+/* ----------------------------------------------------- 
+   Retorna a altura da arvore com raiz em p
+   Percurso em pós-ordem com pilha explícita: a pilha guarda sempre o
+   caminho da raiz até o nodo atual, então a altura é o maior tamanho
+   que ela atinge
+*/
+int alturaArv( ArvBin p ){
+    PilhaNodos s;
+    ApNodo ultimo = NULL, topo;
+    int h = 0;
+
+    criaPilhaNodos( &s );
+    while( p != NULL || s.topo > 0 ){
+        if( p != NULL ){
+            empilhaNodo( &s, p );
+            if( s.topo > h )
+                h = s.topo;
+            p = NODO( p->esq );
+        }
+        else {
+            topo = s.nodos[s.topo - 1];
+            if( NODO( topo->dir ) != NULL && ultimo != NODO( topo->dir ))
+                p = NODO( topo->dir );      /* desce pela direita ainda não visitada */
+            else {
+                ultimo = topo;
+                s.topo--;
+            }
+        }
+    }
+    free( s.nodos );
+    return h;
 }
 
 
@@ -82,9 +264,95 @@ int alturaArv( ArvBin p ){
    Verifica se a árvore está completa
 */
 int arvCompleta( ArvBin arv ){
-  if( contaNoArv( arv ) == pow(2, alturaArv(arv))-1 )
-    return 1;
-  return 0;
+  return formaArv( arv ).perfeita;
+}
+#endif
+
+/* ----------------------------------------------------- 
+   Forma de um nodo a partir das formas das subárvores esq e dir
+   (subárvore vazia: altura 0 e todas as propriedades verdadeiras)
+*/
+FormaArv combinaForma( FormaArv e, FormaArv d, int umFilho ){
+  FormaArv f;
+
+  f.nodos = e.nodos + d.nodos + 1;
+  f.altura = (e.altura > d.altura ? e.altura : d.altura) + 1;
+  f.fatorBalanceamento = e.altura - d.altura;
+  f.perfeita = e.perfeita && d.perfeita && e.altura == d.altura;
+  /* completa: ou o último nível acaba na subárvore direita (esquerda
+     perfeita, mesma altura) ou na esquerda (direita perfeita, um a menos) */
+  f.completa = (e.perfeita && d.completa && e.altura == d.altura) ||
+               (e.completa && d.perfeita && e.altura == d.altura + 1);
+  f.cheia = e.cheia && d.cheia && !umFilho;
+  f.balanceada = e.balanceada && d.balanceada &&
+                 f.fatorBalanceamento >= -1 && f.fatorBalanceamento <= 1;
+  return f;
+}
+
+FormaArv formaVazia( void ){
+  FormaArv f = { 0, 0, 1, 1, 1, 1, 0 };
+
+  return f;
+}
+
+/* ----------------------------------------------------- 
+   Quantidade, altura, perfeição, completude, se é cheia e se é
+   balanceada, em uma única passada em pós-ordem com pilha explícita
+   e só aritmética inteira. As formas das subárvores já terminadas
+   ficam em uma segunda pilha: ao terminar um nodo, as do filho
+   direito e do esquerdo estão no topo
+*/
+FormaArv formaArv( ArvBin p ){
+  PilhaNodos s;
+  FormaArv *formas, e, d;
+  int numFormas = 0, capFormas = 64;
+  ApNodo ultimo = NULL, topo;
+
+  if( p == NULL )
+    return formaVazia();
+  criaPilhaNodos( &s );
+  formas = (FormaArv*) malloc( capFormas * sizeof(FormaArv) );
+  while( p != NULL || s.topo > 0 ){
+    if( p != NULL ){
+      empilhaNodo( &s, p );
+      p = NODO( p->esq );
+      continue;
+    }
+    topo = s.nodos[s.topo - 1];
+    if( NODO( topo->dir ) != NULL && ultimo != NODO( topo->dir )){
+      p = NODO( topo->dir );
+      continue;
+    }
+    d = NODO( topo->dir ) != NULL ? formas[--numFormas] : formaVazia();
+    e = NODO( topo->esq ) != NULL ? formas[--numFormas] : formaVazia();
+    if( numFormas == capFormas ){
+      capFormas *= 2;
+      formas = (FormaArv*) realloc( formas, capFormas * sizeof(FormaArv) );
+    }
+    formas[numFormas++] = combinaForma( e, d, (NODO( topo->esq ) == NULL) != (NODO( topo->dir ) == NULL) );
+    ultimo = topo;
+    s.topo--;
+  }
+  e = formas[0];
+  free( formas );
+  free( s.nodos );
+  return e;
+}
+
+/* ----------------------------------------------------- */
+/* Preenche o nodo p com o Item v, como folha            */
+void preencheNodo( ApNodo p, ItemArv v ){
+#ifdef ARV_INTERNADA
+  p->texto = internaTexto( v );
+  p->prefixo = prefixoTexto( v );
+#else
+  cp(p->item, v);
+#endif
+  p->esq = LIGA( NULL ); p->dir = LIGA( NULL );
+#ifdef ARV_AVL
+  p->altura = 1;
+  p->tamanho = 1;
+#endif
 }
 
 /* ----------------------------------------------------- */
@@ -92,33 +360,286 @@ int arvCompleta( ArvBin arv ){
 ArvBin criaNoArv( ItemArv v ){
   ArvBin p;
 
+#ifdef ARV_ARENA
+  if( !arenaArvCriada ){
+    criaArena( &arenaArv, sizeof(Nodo) );
+    arenaArvCriada = 1;
+  }
+  p = (ArvBin) alocaArena( &arenaArv );
+#else
   p = (ArvBin)malloc( sizeof(Nodo) );
-  cp(p->item, v); p->esq = NULL; p->dir = NULL;
+#endif
+  preencheNodo( p, v );
   return p;
 }
 
+#ifndef ARV_ITEM_INT
+/* ----------------------------------------------------- */
+/* Texto do Item guardado no nodo                         */
+const char *textoNodo( ApNodo p ){
+#ifdef ARV_INTERNADA
+  return texto( p->texto );
+#else
+  return p->item;
+#endif
+}
+#endif
+
+#ifndef ARV_AVL
 /* ----------------------------------------------------- 
 /* Insere um novo Item na árvore */
 ArvBin insereArv( ItemArv v, ArvBin arv ){
-  ArvBin p;
+  /* sem recursão: lugar aponta a ligação (raiz, esq ou dir) que vai
+     receber o nodo novo, então inserções ordenadas não estouram a
+     pilha de execução; a raiz vai para uma ligação local para ser
+     tratada como os filhos */
+  ApNodo novo = criaNoArv( v ), p;
+  LigaNodo raiz = LIGA( arv ), *lugar = &raiz;
 
-  if( arvVazia( arv ))
-    return criaNoArv( v );
-  if( leq(v, arv->item ))
-    arv->esq= insereArv( v, arv->esq );
-  else
-    arv->dir= insereArv( v, arv->dir );
+  while(( p = NODO( *lugar )) != NULL )
+#ifdef ARV_INTERNADA
+    /* cada comparação é, quase sempre, só a dos prefixos */
+    if( comparaInternados( novo->prefixo, novo->texto,
+                           p->prefixo, p->texto ) <= 0 )
+#else
+    if( leq( v, p->item ))
+#endif
+      lugar = &p->esq;
+    else
+      lugar = &p->dir;
+  *lugar = LIGA( novo );
+  return NODO( raiz );
+}
+#endif
+
+/* ----------------------------------------------------- 
+   Retorna um nodo com o Item v ou NULL se não existir
+   (na AVL itens iguais podem ficar dos dois lados depois de
+   rotações, mas a busca para no primeiro que encontrar)
+*/
+ApNodo buscaArv( ItemArv v, ArvBin arv ){
+#ifdef ARV_INTERNADA
+  /* um texto que nunca foi internado não está em nenhuma árvore */
+  unsigned int t = procuraTexto( v ), pref = prefixoTexto( v );
+
+  if( t == 0 )
+    return NULL;
+  while( arv != NULL && arv->texto != t ){
+    if( comparaInternados( pref, t, arv->prefixo, arv->texto ) < 0 )
+      arv= NODO( arv->esq );
+    else
+      arv= NODO( arv->dir );
+  }
+  return arv;
+#else
+  while( arv != NULL && !eq( v, arv->item )){
+    if( lt( v, arv->item ))
+      arv= NODO( arv->esq );
+    else
+      arv= NODO( arv->dir );
+  }
   return arv;
+#endif
 }
 
 /* ----------------------------------------------------- */
-/* Libera espaço alocado para toda a árvore              */
+int comparaItens( const void *a, const void *b ){
+  const ItemArv *x = a, *y = b;
+
+  return lt( *x, *y ) ? -1 : gt( *x, *y );
+}
+
+/* ----------------------------------------------------- 
+   Liga nodos[*prox..] em pré-ordem como a árvore balanceada de
+   itens[ini..fim] (com nodos == NULL, cada nodo vem de criaNoArv)
+*/
+ArvBin montaTrecho( ItemArv *itens, int ini, int fim, Nodo *nodos, int *prox ){
+  ApNodo p;
+  int meio;
+
+  if( ini > fim )
+    return NULL;
+  meio = ini + (fim - ini) / 2;
+  if( nodos != NULL )
+    preencheNodo( p = &nodos[(*prox)++], itens[meio] );
+  else
+    p = criaNoArv( itens[meio] );
+  p->esq = LIGA( montaTrecho( itens, ini, meio - 1, nodos, prox ));
+  p->dir = LIGA( montaTrecho( itens, meio + 1, fim, nodos, prox ));
+#ifdef ARV_AVL
+  atualizaAltura( p );
+#endif
+  return p;
+}
+
+/* ----------------------------------------------------- 
+   Monta de uma vez a árvore perfeitamente balanceada (altura mínima)
+   com os *n itens do vetor, que é ordenado no lugar se preciso; com
+   DESCARTA_REPETIDOS os itens iguais ficam só uma vez e *n recebe o
+   novo total. Com o vetor já ordenado é O(n), e os nodos ocupam um
+   único bloco
+*/
+ArvBin montaArv( ItemArv *itens, int *n, int repetidos ){
+  Nodo *nodos = NULL;
+  int i, k, prox = 0;
+
+  for( i = 1; i < *n && leq( itens[i-1], itens[i] ); i++ )
+    ;
+  if( i < *n )
+    qsort( itens, *n, sizeof(ItemArv), comparaItens );
+  if( repetidos == DESCARTA_REPETIDOS && *n > 0 ){
+    for( i = k = 1; i < *n; i++ )
+      if( !eq( itens[i], itens[k-1] )){
+        if( k != i )
+          cp( itens[k], itens[i] );
+        k++;
+      }
+    *n = k;
+  }
+  if( *n == 0 )
+    return NULL;
+#ifndef ARV_ARENA
+  /* sem espaço na tabela de blocos, volta aos nodos um a um */
+  if( numBlocosArv < MAX_BLOCOS_ARV )
+    nodos = (Nodo*) malloc( (size_t)*n * sizeof(Nodo) );
+  if( nodos != NULL ){
+    blocosArv[numBlocosArv].nodos = nodos;
+    blocosArv[numBlocosArv].n = blocosArv[numBlocosArv].vivos = *n;
+    numBlocosArv++;
+  }
+#endif
+  return montaTrecho( itens, 0, *n - 1, nodos, &prox );
+}
+
+/* ----------------------------------------------------- 
+   Libera espaço alocado para toda a árvore (e só para ela)
+   Enquanto a raiz tem filho esquerdo, gira à direita; quando não tem,
+   libera a raiz e segue pelo filho direito. Espaço extra O(1)
+*/
 void freeArv( ArvBin p ){
-  if( p != NULL ){
-    freeArv( p->esq );
-    freeArv( p->dir );
-    free( p );
+  ApNodo q;
+
+  while( p != NULL ){
+    if( NODO( p->esq ) != NULL ){
+      q = NODO( p->esq );
+      p->esq = q->dir;
+      q->dir = LIGA( p );
+      p = q;
+    }
+    else {
+      q = NODO( p->dir );
+      liberaNodo( p );
+      p = q;
+    }
+  }
+}
+
+#ifdef ARV_ARENA
+/* ----------------------------------------------------- 
+   Libera de uma vez todas as árvores criadas até aqui, devolvendo a
+   arena inteira (sem percorrer os nodos); nenhuma pode ser usada depois
+*/
+void liberaTodasArv( void ){
+  liberaArena( &arenaArv );
+}
+#endif
+
+/* ----------------------------------------------------- 
+   Copia os itens em ordem para o vetor v (percurso com pilha explícita)
+*/
+void copiaEmOrdem( ArvBin p, ItemArv *v ){
+  PilhaNodos s;
+  int i = 0;
+
+  criaPilhaNodos( &s );
+  while( p != NULL || s.topo > 0 ){
+    if( p != NULL ){
+      empilhaNodo( &s, p );
+      p = NODO( p->esq );
+    }
+    else {
+      p = s.nodos[--s.topo];
+#ifdef ARV_INTERNADA
+      cp( v[i++], textoNodo( p ));
+#else
+      cp( v[i++], p->item );
+#endif
+      p = NODO( p->dir );
+    }
   }
+  free( s.nodos );
 }
 
+/* ----------------------------------------------------- 
+   Preenche a subárvore k do vetor de Eytzinger com os itens
+   ordenados a partir de *prox (profundidade log n)
+*/
+void preencheCongelada( ArvCongelada *a, ItemArv *ordenados, int *prox, int k ){
+  if( k > a->n )
+    return;
+  preencheCongelada( a, ordenados, prox, 2*k );
+  cp( a->itens[k], ordenados[(*prox)++] );
+  preencheCongelada( a, ordenados, prox, 2*k + 1 );
+}
 
+/* ----------------------------------------------------- 
+   Copia os itens da árvore, em ordem, para um vetor de Eytzinger
+   alinhado à linha de cache; a árvore não é alterada e pode ser
+   liberada depois
+*/
+ArvCongelada congelaArv( ArvBin arv ){
+  ArvCongelada a;
+  ItemArv *ordenados;
+  int prox = 0;
+  size_t bytes;
+
+  a.n = contaNoArv( arv );
+  ordenados = (ItemArv*) malloc( (a.n > 0 ? a.n : 1) * sizeof(ItemArv) );
+  copiaEmOrdem( arv, ordenados );
+  bytes = ((a.n + 1) * sizeof(ItemArv) + 63) / 64 * 64;
+  a.itens = (ItemArv*) aligned_alloc( 64, bytes );
+  preencheCongelada( &a, ordenados, &prox, 1 );
+  free( ordenados );
+  return a;
+}
+
+/* ----------------------------------------------------- 
+   Retorna 1 se v está na árvore congelada e 0 caso contrário
+   Desce sempre até passar do fim do vetor (o caminho não depende
+   de desvios imprevisíveis) buscando antecipadamente os nodos dois
+   níveis abaixo; os bits 1 finais de k são as descidas à direita
+   depois da última à esquerda, e removê-los dá o menor item >= v
+*/
+int buscaCongelada( ItemArv v, ArvCongelada *a ){
+  int k = 1;
+
+  while( k <= a->n ){
+    __builtin_prefetch( a->itens + 4*k );
+    k = 2*k + lt( a->itens[k], v );
+  }
+  k >>= __builtin_ffs( ~k );
+  return k != 0 && eq( a->itens[k], v );
+}
+
+/* ----------------------------------------------------- */
+void liberaCongelada( ArvCongelada *a ){
+  free( a->itens );
+  a->itens = NULL;
+  a->n = 0;
+}
+
+/* ----------------------------------------------------- */
+/* Uso de memória dos nodos                               */
+void relatorioMemoriaArv( void ){
+#ifdef ARV_ARENA
+  if( arenaArvCriada )
+    relatorioArena( &arenaArv, stdout );
+#else
+  printf( "nodos de %zu bytes alocados um a um com malloc\n", sizeof(Nodo) );
+  if( numBlocosArv > 0 )
+    printf( "%d blocos de nodos de montaArv em uso\n", numBlocosArv );
+#endif
+#ifdef ARV_INTERNADA
+  printf( "textos internados: %zu bytes\n", memoriaTextos() );
+#endif
+}
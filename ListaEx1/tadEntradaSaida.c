@@ -0,0 +1,326 @@
+/*---------------------------------------------------------
+Implementação: TAD EntradaSaida
+-----------------------------------------------------------*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <errno.h>
+#include <math.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "entradaSaida.h"
+
+#define TAM_BUFFER_ENTRADA (1 << 20)
+#define TAM_BUFFER_SAIDA (1 << 20)
+
+/* Trecho da entrada ainda não consumido: [posEntrada, fimEntrada) */
+static char *posEntrada = NULL, *fimEntrada = NULL;
+static char *bufferEntrada = NULL;
+static int entradaMapeada = 0, entradaAcabou = 0;
+
+/* -----------------------------------------------------
+   Antes de main: com stdout redirecionada para arquivo ou pipe, troca
+   o buffer padrão (alguns KB) por um de TAM_BUFFER_SAIDA. Precisa ser
+   feito antes de qualquer escrita, por isso não fica na primeira
+   chamada de escreveXxx
+*/
+__attribute__((constructor))
+void iniciaSaida( void ){
+  if( !isatty( 1 ))
+    setvbuf( stdout, NULL, _IOFBF, TAM_BUFFER_SAIDA );
+}
+
+/* -----------------------------------------------------
+   Na primeira leitura: mapeia a entrada se ela é um arquivo comum
+   (a partir da posição atual), senão cria o buffer que
+   preencheEntrada enche com read(2)
+*/
+void iniciaEntrada( void ){
+  struct stat st;
+  off_t inicio = lseek( 0, 0, SEEK_CUR );
+  char *m;
+
+  if( fstat( 0, &st ) == 0 && S_ISREG( st.st_mode ) && inicio >= 0 &&
+      st.st_size > inicio ){
+    m = (char*) mmap( NULL, st.st_size, PROT_READ, MAP_PRIVATE, 0, 0 );
+    if( m != MAP_FAILED ){
+      madvise( m, st.st_size, MADV_SEQUENTIAL );
+      posEntrada = m + inicio;
+      fimEntrada = m + st.st_size;
+      entradaMapeada = 1;
+      return;
+    }
+  }
+  bufferEntrada = (char*) malloc( TAM_BUFFER_ENTRADA );
+  posEntrada = fimEntrada = bufferEntrada;
+}
+
+/* -----------------------------------------------------
+   Garante ao menos um caractere não consumido; retorna 0 no fim
+   da entrada
+*/
+int preencheEntrada( void ){
+  ssize_t lidos;
+
+  if( posEntrada < fimEntrada )
+    return 1;
+  if( posEntrada == NULL ){
+    iniciaEntrada();
+    if( posEntrada < fimEntrada )
+      return 1;
+  }
+  if( entradaMapeada || entradaAcabou || bufferEntrada == NULL )
+    return 0;
+  do
+    lidos = read( 0, bufferEntrada, TAM_BUFFER_ENTRADA );
+  while( lidos < 0 && errno == EINTR );
+  if( lidos <= 0 ){
+    entradaAcabou = 1;
+    return 0;
+  }
+  posEntrada = bufferEntrada;
+  fimEntrada = bufferEntrada + lidos;
+  return 1;
+}
+
+/* ----------------------------------------------------- */
+/* Próximo caractere sem consumir (EOF no fim)            */
+int espiaEntrada( void ){
+  if( posEntrada >= fimEntrada && !preencheEntrada() )
+    return EOF;
+  return (unsigned char) *posEntrada;
+}
+
+/* ----------------------------------------------------- */
+int ehEspaco( int c ){
+  return c == ' ' || c == '\n' || c == '\t' || c == '\r' ||
+         c == '\v' || c == '\f';
+}
+
+int ehDigito( int c ){
+  return c >= '0' && c <= '9';
+}
+
+/* -----------------------------------------------------
+   Pula os espaços como scanf; retorna o primeiro caractere
+   depois deles (sem consumir) ou EOF
+*/
+int pulaEspacos( void ){
+  int c;
+
+  while( (c = espiaEntrada()) != EOF && ehEspaco( c ))
+    posEntrada++;
+  return c;
+}
+
+/* -----------------------------------------------------
+   Lê um inteiro decimal com sinal opcional, como "%d"
+   (valores fora de int dão o resultado truncado, como em scanf)
+*/
+int leInt( int *v ){
+  unsigned int x = 0;
+  int c, negativo = 0;
+
+  if( (c = pulaEspacos()) == EOF )
+    return EOF;
+  if( c == '-' || c == '+' ){
+    negativo = c == '-';
+    posEntrada++;
+    c = espiaEntrada();
+  }
+  if( !ehDigito( c ))
+    return 0;
+  do {
+    x = x * 10 + (unsigned int)(c - '0');
+    posEntrada++;
+  } while( ehDigito( c = espiaEntrada() ));
+  *v = (int)( negativo ? 0u - x : x );
+  return 1;
+}
+
+/* -----------------------------------------------------
+   Consome o caractere c e o acrescenta a t (de tamanho tam), se
+   houver lugar; retorna o próximo caractere da entrada
+*/
+int guardaCaractere( char *t, int *n, int tam, int c ){
+  if( *n < tam - 1 )
+    t[(*n)++] = (char) c;
+  posEntrada++;
+  return espiaEntrada();
+}
+
+/* Texto do número que leFloat passa a strtof; cresce com ele, então
+   nenhum dígito ou expoente é cortado */
+static char *token = NULL;
+static int capToken = 0;
+
+/* -----------------------------------------------------
+   Consome o caractere c e o acrescenta a token[0..*n), deixando
+   lugar para o '\0'; retorna o próximo caractere da entrada
+*/
+int guardaToken( int *n, int c ){
+  if( *n + 1 >= capToken ){
+    capToken = capToken > 0 ? 2 * capToken : 128;
+    token = (char*) realloc( token, capToken );
+    if( token == NULL ){
+      fprintf( stderr, "EntradaSaida: falha ao alocar %d bytes\n", capToken );
+      exit( 1 );
+    }
+  }
+  token[(*n)++] = (char) c;
+  posEntrada++;
+  return espiaEntrada();
+}
+
+/* -----------------------------------------------------
+   Lê um float como "%f": [sinal] dígitos [. dígitos] [e [sinal]
+   dígitos], ou inf/nan. O caso comum (até 7 dígitos significativos
+   e expoente decimal até 10) é convertido à mão com uma única
+   operação exata em float, o mesmo arredondamento de strtof; o resto
+   vai para strtof
+*/
+int leFloat( float *v ){
+  static const float potencias[] = { 1e0f, 1e1f, 1e2f, 1e3f, 1e4f, 1e5f,
+                                     1e6f, 1e7f, 1e8f, 1e9f, 1e10f };
+  char *resto;
+  unsigned long mantissa = 0;
+  int c, n = 0, negativo = 0, digitos = 0, casas = 0;
+  int expoente = 0, negativoExp = 0;
+  float x;
+
+  if( (c = pulaEspacos()) == EOF )
+    return EOF;
+  if( c == '-' || c == '+' ){
+    negativo = c == '-';
+    c = guardaToken( &n, c );
+  }
+  if( c != EOF && !ehDigito( c ) && c != '.' ){
+    /* inf, nan: a palavra inteira vai para strtof (e fica consumida
+       mesmo que não seja nenhum dos dois) */
+    while( c != EOF && !ehEspaco( c ))
+      c = guardaToken( &n, c );
+    token[n] = '\0';
+    x = strtof( token, &resto );
+    if( resto == token || *resto != '\0' )
+      return 0;
+    *v = x;
+    return 1;
+  }
+  for( ; ehDigito( c ); digitos++ ){
+    mantissa = mantissa * 10 + (unsigned long)(c - '0');
+    c = guardaToken( &n, c );
+  }
+  if( c == '.' )
+    for( c = guardaToken( &n, c ); ehDigito( c ); digitos++, casas++ ){
+      mantissa = mantissa * 10 + (unsigned long)(c - '0');
+      c = guardaToken( &n, c );
+    }
+  if( digitos == 0 )
+    return 0;
+  if( c == 'e' || c == 'E' ){
+    c = guardaToken( &n, c );
+    if( c == '-' || c == '+' ){
+      negativoExp = c == '-';
+      c = guardaToken( &n, c );
+    }
+    while( ehDigito( c )){
+      if( expoente < 100000 )
+        expoente = expoente * 10 + (c - '0');
+      c = guardaToken( &n, c );
+    }
+  }
+  token[n] = '\0';
+
+  if( negativoExp )
+    expoente = -expoente;
+  expoente -= casas;
+  if( digitos <= 7 && expoente >= -10 && expoente <= 10 ){
+    /* mantissa < 2^24 e 10^|expoente| são exatos em float */
+    x = expoente >= 0 ? (float) mantissa * potencias[expoente]
+                      : (float) mantissa / potencias[-expoente];
+    *v = negativo ? -x : x;
+    return 1;
+  }
+  x = strtof( token, &resto );
+  *v = x;
+  return 1;
+}
+
+/* -----------------------------------------------------
+   Lê uma palavra (sem espaços) como "%s", guardando até tam-1
+   caracteres; o resto de uma palavra maior é descartado em vez de
+   passar do fim de t
+*/
+int leTexto( char *t, int tam ){
+  int c, n = 0;
+
+  if( (c = pulaEspacos()) == EOF )
+    return EOF;
+  while( c != EOF && !ehEspaco( c ))
+    c = guardaCaractere( t, &n, tam, c );
+  t[n] = '\0';
+  return 1;
+}
+
+/* ----------------------------------------------------- */
+/* Escreve os n caracteres de t em stdout                 */
+void escreveBytes( const char *t, int n ){
+  fwrite( t, 1, n, stdout );
+}
+
+/* -----------------------------------------------------
+   Dígitos decimais de x no fim de t[0..fim), da direita para a
+   esquerda; retorna a posição do primeiro
+*/
+int digitosDecimais( unsigned long long x, char *t, int fim ){
+  do {
+    t[--fim] = (char)('0' + x % 10);
+    x /= 10;
+  } while( x > 0 );
+  return fim;
+}
+
+/* ----------------------------------------------------- */
+void escreveInt( int v ){
+  char t[16];
+  unsigned int x = v < 0 ? 0u - (unsigned int) v : (unsigned int) v;
+  int i = digitosDecimais( x, t, sizeof(t) );
+
+  if( v < 0 )
+    t[--i] = '-';
+  escreveBytes( t + i, sizeof(t) - i );
+}
+
+/* -----------------------------------------------------
+   Como "%f" (6 casas). Um float tem 24 bits de mantissa e 10^6 =
+   2^6 * 15625 precisa de 14, então v * 10^6 é exato em double e
+   arredondá-lo para inteiro (metade para o par, como printf) dá
+   exatamente as casas de printf; valores muito grandes, inf e nan
+   ficam com printf
+*/
+void escreveFloat( float v ){
+  char t[48];
+  double d = (double) v * 1e6, a;
+  unsigned long long q;
+  int i, neg = signbit( v ) != 0;
+
+  a = neg ? -d : d;
+  if( !(a < 1e18) ){
+    printf( "%f", v );
+    return;
+  }
+  q = (unsigned long long) a;
+  if( a - (double) q > 0.5 || (a - (double) q == 0.5 && (q & 1)) )
+    q++;
+  i = digitosDecimais( q % 1000000 + 1000000, t, sizeof(t) );
+  t[i] = '.';           /* o 1 da frente vira o ponto */
+  i = digitosDecimais( q / 1000000, t, i );
+  if( neg )
+    t[--i] = '-';
+  escreveBytes( t + i, sizeof(t) - i );
+}
+
+/* ----------------------------------------------------- */
+void escreveTexto( const char *t ){
+  fputs( t, stdout );
+}
@@ -16,13 +16,68 @@ void criaFila( Fila *fila){
   fila->ult = NULL;
 }
 
+/* ----------------------------------------------------- 
+  Nodos liberados ficam em uma lista de livres (uma por thread) e são
+  reaproveitados pelos próximos nodos criados, até RETENCAO_NOS nodos;
+  acima disso voltam para o free(). Compilar com -DRETENCAO_NOS=0
+  desativa o reaproveitamento.
+*/
+#ifndef RETENCAO_NOS
+#define RETENCAO_NOS 4096
+#endif
+
+static _Thread_local ApNoFila nosLivres = NULL;
+static _Thread_local int numNosLivres = 0;
+
+/* ----------------------------------------------------- 
+  Obtém um nodo da lista de livres ou, se ela estiver vazia, do malloc
+*/
+ApNoFila alocaNoFila( void ){
+  ApNoFila p;
+
+  if( nosLivres == NULL )
+    return (ApNoFila) malloc( sizeof(NoFila) );
+  p= nosLivres;
+  nosLivres= p->prox;
+  numNosLivres--;
+  return p;
+}
+
+/* ----------------------------------------------------- 
+  Devolve um nodo para a lista de livres ou, se ela estiver cheia, ao free
+*/
+void liberaNoFila( ApNoFila p ){
+  if( numNosLivres >= RETENCAO_NOS ){
+    free( p );
+    return;
+  }
+  p->prox= nosLivres;
+  nosLivres= p;
+  numNosLivres++;
+}
+
+/* ----------------------------------------------------- 
+  Devolve ao free os nodos guardados na lista de livres da thread que
+  chama; cada thread que usou a fila deve chamá-la antes de terminar
+*/
+void liberaNosLivresFila( void ){
+  ApNoFila p;
+
+  while( nosLivres != NULL ){
+    p= nosLivres;
+    nosLivres= p->prox;
+    free( p );
+  }
+  numNosLivres= 0;
+}
+
 /* ----------------------------------------------------- 
   Criação de um novo nodo com o valor do Item preenchido com v 
 */
 ApNoFila criaNoFila( ItemFila v ){
   ApNoFila p;
 
-  p = (ApNoFila) malloc( sizeof(NoFila) );
+  p = alocaNoFila();
   cp(p->item, v); p->prox = NULL;
   return p;
 }
@@ -65,7 +120,9 @@ void removeFila( Fila *fila, ItemFila *v){
     p= fila->prim;
     cp(*v, p->item);
     fila->prim= p->prox;
-    free( p );
+    if( fila->prim == NULL )
+      fila->ult= NULL;
+    liberaNoFila( p );
   }
 }
 
@@ -0,0 +1,299 @@
+/*---------------------------------------------------------
+IMPLEMENTAÇÃO: TAD Fila concorrente (lock-free)
+-----------------------------------------------------------*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <sched.h>
+
+typedef int ItemFila;
+#include "itemInt.h"
+#include "filaConcorrente.h"
+
+/* =====================================================
+   FilaLimitada: cada célula tem um número de sequência que diz
+   se ela está pronta para a inserção da posição p (seq == p) ou
+   para a remoção da posição p (seq == p+1). Produtores disputam
+   `fim` e consumidores disputam `ini` com CAS; a célula em si só
+   é escrita por quem ganhou a posição.
+   ===================================================== */
+
+/* ----------------------------------------------------- 
+   Cria uma fila com capacidade para pelo menos cap itens
+   Retorna 1 em sucesso e 0 se faltar memória
+*/
+int criaFilaLimitada( FilaLimitada *fila, int cap ){
+  size_t n = 2, i;
+
+  while( n < (size_t)cap )
+    n *= 2;
+  fila->celulas = (CelulaFila*) malloc( n * sizeof(CelulaFila) );
+  if( fila->celulas == NULL )
+    return 0;
+  for( i = 0; i < n; i++ )
+    atomic_store_explicit( &fila->celulas[i].seq, i, memory_order_relaxed );
+  fila->mascara = n - 1;
+  atomic_store( &fila->ini, 0 );
+  atomic_store( &fila->fim, 0 );
+  return 1;
+}
+
+/* ----------------------------------------------------- 
+   Insere v; retorna 1 em sucesso e 0 se a fila estiver cheia
+*/
+int insereFilaLimitada( ItemFila v, FilaLimitada *fila ){
+  CelulaFila *c;
+  size_t pos = atomic_load_explicit( &fila->fim, memory_order_relaxed );
+  size_t seq;
+  long dif;
+
+  for(;;){
+    c = &fila->celulas[pos & fila->mascara];
+    seq = atomic_load_explicit( &c->seq, memory_order_acquire );
+    dif = (long)seq - (long)pos;
+    if( dif == 0 ){
+      if( atomic_compare_exchange_weak_explicit( &fila->fim, &pos, pos + 1,
+                                                 memory_order_relaxed, memory_order_relaxed ))
+        break;
+    }
+    else if( dif < 0 )
+      return 0;   /* a célula ainda guarda um item de uma volta anterior */
+    else
+      pos = atomic_load_explicit( &fila->fim, memory_order_relaxed );
+  }
+  cp( c->item, v );
+  atomic_store_explicit( &c->seq, pos + 1, memory_order_release );
+  return 1;
+}
+
+/* ----------------------------------------------------- 
+   Remove o primeiro item; retorna 1 em sucesso e 0 se vazia
+*/
+int removeFilaLimitada( FilaLimitada *fila, ItemFila *v ){
+  CelulaFila *c;
+  size_t pos = atomic_load_explicit( &fila->ini, memory_order_relaxed );
+  size_t seq;
+  long dif;
+
+  for(;;){
+    c = &fila->celulas[pos & fila->mascara];
+    seq = atomic_load_explicit( &c->seq, memory_order_acquire );
+    dif = (long)seq - (long)(pos + 1);
+    if( dif == 0 ){
+      if( atomic_compare_exchange_weak_explicit( &fila->ini, &pos, pos + 1,
+                                                 memory_order_relaxed, memory_order_relaxed ))
+        break;
+    }
+    else if( dif < 0 )
+      return 0;   /* ninguém escreveu nesta posição ainda */
+    else
+      pos = atomic_load_explicit( &fila->ini, memory_order_relaxed );
+  }
+  cp( *v, c->item );
+  atomic_store_explicit( &c->seq, pos + fila->mascara + 1, memory_order_release );
+  return 1;
+}
+
+/* ----------------------------------------------------- */
+/* Libera o vetor (sem threads usando a fila)             */
+void liberaFilaLimitada( FilaLimitada *fila ){
+  free( fila->celulas );
+  fila->celulas = NULL;
+}
+
+/* =====================================================
+   FilaMS: lista com nodo sentinela em prim. Um nodo removido só
+   pode ser liberado quando nenhuma thread o estiver lendo: antes de
+   acessar um nodo a thread o publica em um dos seus dois hazard
+   pointers, e os nodos retirados ficam em uma lista local até que
+   uma varredura confirme que nenhum hazard pointer os referencia.
+   ===================================================== */
+#define HP_POR_THREAD 2
+#define LIMITE_RETIRADOS (2 * MAX_THREADS_FILA * HP_POR_THREAD)
+
+static _Atomic(ApNoFilaMS) hazard[MAX_THREADS_FILA][HP_POR_THREAD];
+static atomic_int slotOcupado[MAX_THREADS_FILA];
+
+static _Thread_local int slotHP = -1;
+static _Thread_local ApNoFilaMS retirados[LIMITE_RETIRADOS];
+static _Thread_local int numRetirados = 0;
+
+/* ----------------------------------------------------- 
+   Slot de hazard pointers da thread atual (reserva um no 1º uso)
+*/
+int slotThreadMS( void ){
+  int i, livre;
+
+  if( slotHP >= 0 )
+    return slotHP;
+  for( i = 0; i < MAX_THREADS_FILA; i++ ){
+    livre = 0;
+    if( atomic_compare_exchange_strong( &slotOcupado[i], &livre, 1 )){
+      slotHP = i;
+      return i;
+    }
+  }
+  fprintf( stderr, "FilaMS: mais de %d threads simultâneas\n", MAX_THREADS_FILA );
+  exit( 1 );
+}
+
+/* ----------------------------------------------------- 
+   Libera os nodos retirados que nenhum hazard pointer protege
+*/
+void varreRetiradosMS( void ){
+  ApNoFilaMS protegidos[MAX_THREADS_FILA * HP_POR_THREAD];
+  int numProt = 0, mantidos = 0, i, j, seguro;
+
+  for( i = 0; i < MAX_THREADS_FILA; i++ )
+    for( j = 0; j < HP_POR_THREAD; j++ )
+      if(( protegidos[numProt] = atomic_load( &hazard[i][j] )) != NULL )
+        numProt++;
+
+  for( i = 0; i < numRetirados; i++ ){
+    seguro = 1;
+    for( j = 0; j < numProt && seguro; j++ )
+      if( protegidos[j] == retirados[i] )
+        seguro = 0;
+    if( seguro )
+      free( retirados[i] );
+    else
+      retirados[mantidos++] = retirados[i];
+  }
+  numRetirados = mantidos;
+}
+
+/* ----------------------------------------------------- 
+   Adia a liberação de um nodo removido da fila
+*/
+void retiraNoMS( ApNoFilaMS p ){
+  retirados[numRetirados++] = p;
+  if( numRetirados == LIMITE_RETIRADOS )
+    varreRetiradosMS();
+}
+
+/* ----------------------------------------------------- */
+/* Fila vazia: só o nodo sentinela                       */
+void criaFilaMS( FilaMS *fila ){
+  ApNoFilaMS s = (ApNoFilaMS) malloc( sizeof(NoFilaMS) );
+
+  atomic_store( &s->prox, NULL );
+  atomic_store( &fila->prim, s );
+  atomic_store( &fila->ult, s );
+}
+
+/* ----------------------------------------------------- */
+int filaVaziaMS( FilaMS *fila ){
+  int slot = slotThreadMS();
+  ApNoFilaMS prim;
+  int vazia;
+
+  do{
+    prim = atomic_load( &fila->prim );
+    atomic_store( &hazard[slot][0], prim );
+  } while( prim != atomic_load( &fila->prim ));
+  vazia = (atomic_load( &prim->prox ) == NULL);
+  atomic_store( &hazard[slot][0], NULL );
+  return vazia;
+}
+
+/* ----------------------------------------------------- 
+   Encadeia o novo nodo depois de ult e depois tenta avançar ult;
+   quem encontrar ult atrasado ajuda a avançá-lo
+*/
+void insereFilaMS( ItemFila v, FilaMS *fila ){
+  int slot = slotThreadMS();
+  ApNoFilaMS p, ult, prox;
+
+  p = (ApNoFilaMS) malloc( sizeof(NoFilaMS) );
+  if( p == NULL ){
+    fprintf( stderr, "FilaMS: falha ao alocar nodo\n" );
+    exit( 1 );
+  }
+  cp( p->item, v );
+  atomic_store_explicit( &p->prox, NULL, memory_order_relaxed );
+
+  for(;;){
+    ult = atomic_load( &fila->ult );
+    atomic_store( &hazard[slot][0], ult );
+    if( ult != atomic_load( &fila->ult ))
+      continue;
+    prox = atomic_load( &ult->prox );
+    if( prox != NULL ){
+      atomic_compare_exchange_strong( &fila->ult, &ult, prox );
+      continue;
+    }
+    if( atomic_compare_exchange_strong( &ult->prox, &prox, p )){
+      atomic_compare_exchange_strong( &fila->ult, &ult, p );
+      break;
+    }
+  }
+  atomic_store( &hazard[slot][0], NULL );
+}
+
+/* ----------------------------------------------------- 
+   Remove o primeiro item; retorna 1 em sucesso e 0 se vazia
+   O sucessor do sentinela vira o novo sentinela
+*/
+int removeFilaMS( FilaMS *fila, ItemFila *v ){
+  int slot = slotThreadMS();
+  ApNoFilaMS prim, ult, prox;
+
+  for(;;){
+    prim = atomic_load( &fila->prim );
+    atomic_store( &hazard[slot][0], prim );
+    if( prim != atomic_load( &fila->prim ))
+      continue;
+    ult = atomic_load( &fila->ult );
+    prox = atomic_load( &prim->prox );
+    atomic_store( &hazard[slot][1], prox );
+    if( prim != atomic_load( &fila->prim ))
+      continue;
+    if( prox == NULL ){
+      atomic_store( &hazard[slot][0], NULL );
+      atomic_store( &hazard[slot][1], NULL );
+      return 0;
+    }
+    if( prim == ult ){
+      atomic_compare_exchange_strong( &fila->ult, &ult, prox );
+      continue;
+    }
+    cp( *v, prox->item );
+    if( atomic_compare_exchange_strong( &fila->prim, &prim, prox ))
+      break;
+  }
+  atomic_store( &hazard[slot][0], NULL );
+  atomic_store( &hazard[slot][1], NULL );
+  retiraNoMS( prim );
+  return 1;
+}
+
+/* ----------------------------------------------------- */
+/* Libera os nodos da fila (sem threads usando a fila)    */
+void liberaFilaMS( FilaMS *fila ){
+  ApNoFilaMS p = atomic_load( &fila->prim ), q;
+
+  while( p != NULL ){
+    q = atomic_load( &p->prox );
+    free( p );
+    p = q;
+  }
+  atomic_store( &fila->prim, NULL );
+  atomic_store( &fila->ult, NULL );
+}
+
+/* ----------------------------------------------------- 
+   Deve ser chamada por cada thread que usou FilaMS antes de terminar:
+   espera os nodos retirados ficarem livres, libera-os e devolve o slot
+*/
+void encerraThreadFilaMS( void ){
+  if( slotHP < 0 )
+    return;
+  varreRetiradosMS();
+  while( numRetirados > 0 ){
+    sched_yield();
+    varreRetiradosMS();
+  }
+  atomic_store( &hazard[slotHP][0], NULL );
+  atomic_store( &hazard[slotHP][1], NULL );
+  atomic_store( &slotOcupado[slotHP], 0 );
+  slotHP = -1;
+}
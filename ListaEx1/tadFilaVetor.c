@@ -0,0 +1,133 @@
+/*---------------------------------------------------------
+IMPLEMENTAÇÃO: TAD Fila (vetor circular)
+-----------------------------------------------------------*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+typedef int ItemFila;
+#include "itemInt.h"
+#include "filaVetor.h"
+
+/* ----------------------------------------------------- */
+/* Função de inicialização de uma fila vazia 
+*/
+void criaFila( Fila *fila ){
+  fila->item = (ItemFila*) malloc( FILA_CAP_INICIAL * sizeof(ItemFila) );
+  if( fila->item == NULL ){
+    fprintf( stderr, "Fila: falha ao alocar %d itens\n", FILA_CAP_INICIAL );
+    exit( 1 );
+  }
+  fila->cap = FILA_CAP_INICIAL;
+  fila->prim = 0;
+  fila->tam = 0;
+}
+
+/* ----------------------------------------------------- 
+   Retorna 1 se a fila estiver vazia e 0, caso contrario
+*/
+int filaVazia( Fila p ){
+    if( p.tam == 0 )
+        return 1;
+    return 0;
+}
+
+/* ----------------------------------------------------- 
+   Garante espaço para mais n itens, dobrando a capacidade
+   quantas vezes for preciso (depois de liberaFila, cap é 0 e o
+   vetor recomeça de FILA_CAP_INICIAL)
+*/
+void garanteCapFila( Fila *fila, int n ){
+  int capAntiga = fila->cap;
+  int cap = capAntiga < FILA_CAP_INICIAL ? FILA_CAP_INICIAL : capAntiga;
+  int dobra;
+
+  while( fila->tam + n > cap )
+    cap *= 2;
+  if( cap == capAntiga )
+    return;
+
+  fila->item = (ItemFila*) realloc( fila->item, cap * sizeof(ItemFila) );
+  if( fila->item == NULL ){
+    fprintf( stderr, "Fila: falha ao alocar %d itens\n", cap );
+    exit( 1 );
+  }
+  /* Se a fila dava a volta no vetor antigo, a parte do início
+     passa para logo depois do fim antigo */
+  dobra = fila->prim + fila->tam - capAntiga;
+  if( dobra > 0 )
+    memcpy( fila->item + capAntiga, fila->item, dobra * sizeof(ItemFila) );
+  fila->cap = cap;
+}
+
+/* ----------------------------------------------------- 
+   Insere um novo Item na Fila 
+*/
+void insereFila( ItemFila v, Fila *fila ){
+  if( fila->tam == fila->cap )
+    garanteCapFila( fila, 1 );
+  cp( fila->item[(fila->prim + fila->tam) & (fila->cap - 1)], v );
+  fila->tam++;
+}
+
+/* ----------------------------------------------------- 
+   Remove o primeiro Item da fila 
+*/
+void removeFila( Fila *fila, ItemFila *v ){
+  if( filaVazia( *fila ))
+    cp( *v, ERRO );
+  else{
+    cp( *v, fila->item[fila->prim] );
+    fila->prim = (fila->prim + 1) & (fila->cap - 1);
+    fila->tam--;
+  }
+}
+
+/* ----------------------------------------------------- 
+   Insere n Itens do vetor v, na ordem, com no máximo duas cópias
+*/
+void insereFilaLote( ItemFila *v, int n, Fila *fila ){
+  int fim, trecho;
+
+  if( n <= 0 )
+    return;
+  garanteCapFila( fila, n );
+  fim = (fila->prim + fila->tam) & (fila->cap - 1);
+  trecho = fila->cap - fim;
+  if( trecho > n )
+    trecho = n;
+  memcpy( fila->item + fim, v, trecho * sizeof(ItemFila) );
+  memcpy( fila->item, v + trecho, (n - trecho) * sizeof(ItemFila) );
+  fila->tam += n;
+}
+
+/* ----------------------------------------------------- 
+   Remove até n Itens para o vetor v, na ordem
+   Retorna quantos Itens foram removidos
+*/
+int removeFilaLote( Fila *fila, ItemFila *v, int n ){
+  int trecho;
+
+  if( n > fila->tam )
+    n = fila->tam;
+  if( n <= 0 )
+    return 0;
+  trecho = fila->cap - fila->prim;
+  if( trecho > n )
+    trecho = n;
+  memcpy( v, fila->item + fila->prim, trecho * sizeof(ItemFila) );
+  memcpy( v + trecho, fila->item, (n - trecho) * sizeof(ItemFila) );
+  fila->prim = (fila->prim + n) & (fila->cap - 1);
+  fila->tam -= n;
+  return n;
+}
+
+/* ----------------------------------------------------- */
+/* Libera o vetor da fila                                */
+void liberaFila( Fila *fila ){
+  free( fila->item );
+  fila->item = NULL;
+  fila->cap = 0;
+  fila->prim = 0;
+  fila->tam = 0;
+}
@@ -15,13 +15,68 @@ void criaPilha(Pilha *pilha){
   *pilha = NULL;
 }
 
+/* ----------------------------------------------------- 
+  Nodos liberados ficam em uma lista de livres (uma por thread) e são
+  reaproveitados pelos próximos nodos criados, até RETENCAO_NOS nodos;
+  acima disso voltam para o free(). Compilar com -DRETENCAO_NOS=0
+  desativa o reaproveitamento.
+*/
+#ifndef RETENCAO_NOS
+#define RETENCAO_NOS 4096
+#endif
+
+static _Thread_local Pilha nosLivres = NULL;
+static _Thread_local int numNosLivres = 0;
+
+/* ----------------------------------------------------- 
+  Obtém um nodo da lista de livres ou, se ela estiver vazia, do malloc
+*/
+Pilha alocaNoPilha( void ){
+  Pilha p;
+
+  if( nosLivres == NULL )
+    return (Pilha) malloc( sizeof(NoPilha) );
+  p= nosLivres;
+  nosLivres= p->prox;
+  numNosLivres--;
+  return p;
+}
+
+/* ----------------------------------------------------- 
+  Devolve um nodo para a lista de livres ou, se ela estiver cheia, ao free
+*/
+void liberaNoPilha( Pilha p ){
+  if( numNosLivres >= RETENCAO_NOS ){
+    free( p );
+    return;
+  }
+  p->prox= nosLivres;
+  nosLivres= p;
+  numNosLivres++;
+}
+
+/* ----------------------------------------------------- 
+  Devolve ao free os nodos guardados na lista de livres da thread que
+  chama; cada thread que usou a pilha deve chamá-la antes de terminar
+*/
+void liberaNosLivresPilha( void ){
+  Pilha p;
+
+  while( nosLivres != NULL ){
+    p= nosLivres;
+    nosLivres= p->prox;
+    free( p );
+  }
+  numNosLivres= 0;
+}
+
 /* ----------------------------------------------------- 
   Criação de um novo nodo com o valor do Item preenchido com v 
 */
 Pilha criaNoPilha( ItemPilha v ){
   Pilha p;
 
-  p = (Pilha)malloc( sizeof(NoPilha) );
+  p = alocaNoPilha();
   cp(p->item, v); p->prox = NULL;
   return p;
 }
@@ -58,7 +113,7 @@ void desempilha( Pilha *pilha, ItemPilha *v){
     p= *pilha;
     cp(*v, p->item);
     *pilha= p->prox;
-    free( p );
+    liberaNoPilha( p );
   }
 }
 
@@ -0,0 +1,216 @@
+/*---------------------------------------------------------
+IMPLEMENTAÇÃO: TAD Pilha concorrente (lock-free)
+-----------------------------------------------------------*/
+#include <stdio.h>
+#include <stdlib.h>
+
+typedef int ItemPilha;
+#include "itemInt.h"
+#include "pilhaConcorrente.h"
+
+#define INDICE(t) ((uint32_t)(t))
+#define VERSAO(t) ((uint32_t)((t) >> 32))
+#define MARCA(versao, indice) (((uint64_t)(versao) << 32) | (uint32_t)(indice))
+
+/* ----------------------------------------------------- */
+/* Pilha vazia e reservatório sem blocos                 */
+void criaPilhaConc( PilhaConc *pilha ){
+  int i;
+
+  atomic_store( &pilha->topo, 0 );
+  atomic_store( &pilha->livres, 0 );
+  atomic_store( &pilha->proxIndice, 1 );
+  for( i = 0; i < MAX_BLOCOS_PILHA; i++ )
+    atomic_store( &pilha->blocos[i], NULL );
+  for( i = 0; i < TAM_ELIMINACAO; i++ )
+    atomic_store( &pilha->eliminacao[i].oferta, 0 );
+}
+
+/* ----------------------------------------------------- 
+   Nodo de índice i (i >= 1). O bloco k guarda os índices
+   [B*(2^k - 1) + 1, B*(2^(k+1) - 1)], com B = 2^BITS_BLOCO_INICIAL
+*/
+NoPilhaConc *noPilhaConc( PilhaConc *pilha, uint32_t i ){
+  uint64_t j = (uint64_t) i - 1 + (1u << BITS_BLOCO_INICIAL);
+  int k = 63 - __builtin_clzll( j ) - BITS_BLOCO_INICIAL;
+
+  return atomic_load_explicit( &pilha->blocos[k], memory_order_acquire )
+         + ( j - ((uint64_t) 1 << (k + BITS_BLOCO_INICIAL)) );
+}
+
+/* ----------------------------------------------------- 
+   Empilha o nodo i em uma pilha de índices com versão (topo ou livres)
+   Uma única tentativa; retorna 1 se o CAS deu certo
+*/
+int tentaEmpilharIndice( PilhaConc *pilha, _Atomic uint64_t *cab, uint32_t i ){
+  uint64_t velho = atomic_load_explicit( cab, memory_order_relaxed );
+
+  atomic_store_explicit( &noPilhaConc( pilha, i )->prox, INDICE(velho), memory_order_relaxed );
+  return atomic_compare_exchange_weak_explicit( cab, &velho, MARCA( VERSAO(velho) + 1, i ),
+                                                memory_order_release, memory_order_relaxed );
+}
+
+/* ----------------------------------------------------- 
+   Uma tentativa de desempilhar de uma pilha de índices com versão
+   Retorna 1 e o índice em *i, 0 se vazia ou -1 se o CAS falhou.
+   Ler prox de um nodo que outra thread acabou de retirar é seguro
+   porque os nodos nunca voltam ao free() antes de liberaPilhaConc;
+   a versão faz o CAS falhar se o topo mudou nesse meio-tempo.
+*/
+int tentaDesempilharIndice( PilhaConc *pilha, _Atomic uint64_t *cab, uint32_t *i ){
+  uint64_t velho = atomic_load_explicit( cab, memory_order_acquire );
+  uint32_t prox;
+
+  if( INDICE(velho) == 0 )
+    return 0;
+  prox = atomic_load_explicit( &noPilhaConc( pilha, INDICE(velho) )->prox, memory_order_relaxed );
+  if( !atomic_compare_exchange_weak_explicit( cab, &velho, MARCA( VERSAO(velho) + 1, prox ),
+                                              memory_order_acquire, memory_order_relaxed ))
+    return -1;
+  *i = INDICE(velho);
+  return 1;
+}
+
+/* ----------------------------------------------------- 
+   Obtém um nodo livre: da lista de livres ou de um índice novo,
+   alocando o bloco correspondente se ainda não existir.
+   Retorna 0 se faltar memória
+*/
+uint32_t alocaNoPilhaConc( PilhaConc *pilha ){
+  uint32_t i;
+  uint64_t j;
+  int k, r;
+  NoPilhaConc *bloco, *esperado;
+
+  while(( r = tentaDesempilharIndice( pilha, &pilha->livres, &i )) != 0 )
+    if( r == 1 )
+      return i;
+
+  i = atomic_fetch_add( &pilha->proxIndice, 1 );
+  j = (uint64_t) i - 1 + (1u << BITS_BLOCO_INICIAL);
+  k = 63 - __builtin_clzll( j ) - BITS_BLOCO_INICIAL;
+  if( k >= MAX_BLOCOS_PILHA )
+    return 0;
+  if( atomic_load_explicit( &pilha->blocos[k], memory_order_acquire ) == NULL ){
+    bloco = (NoPilhaConc*) calloc( (size_t) 1 << (k + BITS_BLOCO_INICIAL), sizeof(NoPilhaConc) );
+    if( bloco == NULL )
+      return 0;
+    esperado = NULL;
+    if( !atomic_compare_exchange_strong( &pilha->blocos[k], &esperado, bloco ))
+      free( bloco );   /* outra thread instalou o bloco antes */
+  }
+  return i;
+}
+
+/* ----------------------------------------------------- */
+/* Devolve o nodo i à lista de livres da pilha            */
+void liberaNoPilhaConc( PilhaConc *pilha, uint32_t i ){
+  while( !tentaEmpilharIndice( pilha, &pilha->livres, i ))
+    ;
+}
+
+/* ----------------------------------------------------- */
+/* Gerador por thread para sortear o slot de eliminação   */
+static _Thread_local uint32_t sementeElim = 0;
+
+int sorteiaSlot( void ){
+  if( sementeElim == 0 )
+    sementeElim = (uint32_t)(uintptr_t) &sementeElim | 1;
+  sementeElim ^= sementeElim << 13;
+  sementeElim ^= sementeElim >> 17;
+  sementeElim ^= sementeElim << 5;
+  return sementeElim % TAM_ELIMINACAO;
+}
+
+/* ----------------------------------------------------- 
+   Oferece o nodo i em um slot de eliminação e espera um pouco por
+   um desempilha. Retorna 1 se algum desempilha levou o nodo
+*/
+int eliminaEmpilha( PilhaConc *pilha, uint32_t i ){
+  _Atomic uint64_t *slot = &pilha->eliminacao[sorteiaSlot()].oferta;
+  uint64_t velho = atomic_load_explicit( slot, memory_order_relaxed ), oferta;
+  int espera;
+
+  if( INDICE(velho) != 0 )
+    return 0;
+  oferta = MARCA( VERSAO(velho) + 1, i );
+  if( !atomic_compare_exchange_strong_explicit( slot, &velho, oferta,
+                                                memory_order_release, memory_order_relaxed ))
+    return 0;
+  for( espera = 0; espera < ESPERA_ELIMINACAO; espera++ )
+    if( atomic_load_explicit( slot, memory_order_relaxed ) != oferta )
+      return 1;
+  /* ninguém apareceu: retira a oferta; se o CAS falhar, foi levada */
+  return !atomic_compare_exchange_strong_explicit( slot, &oferta, MARCA( VERSAO(oferta) + 1, 0 ),
+                                                   memory_order_relaxed, memory_order_relaxed );
+}
+
+/* ----------------------------------------------------- 
+   Tenta levar um nodo oferecido em um slot de eliminação
+   Retorna 1 e o índice em *i se conseguiu
+*/
+int eliminaDesempilha( PilhaConc *pilha, uint32_t *i ){
+  _Atomic uint64_t *slot = &pilha->eliminacao[sorteiaSlot()].oferta;
+  uint64_t velho;
+  int espera;
+
+  for( espera = 0; espera < ESPERA_ELIMINACAO; espera++ ){
+    velho = atomic_load_explicit( slot, memory_order_acquire );
+    if( INDICE(velho) != 0 &&
+        atomic_compare_exchange_strong_explicit( slot, &velho, MARCA( VERSAO(velho) + 1, 0 ),
+                                                 memory_order_acquire, memory_order_relaxed )){
+      *i = INDICE(velho);
+      return 1;
+    }
+  }
+  return 0;
+}
+
+/* ----------------------------------------------------- */
+int pilhaVaziaConc( PilhaConc *pilha ){
+  return INDICE( atomic_load( &pilha->topo )) == 0;
+}
+
+/* ----------------------------------------------------- 
+   Empilha v; retorna 0 se faltar memória
+*/
+int empilhaConc( ItemPilha v, PilhaConc *pilha ){
+  uint32_t i = alocaNoPilhaConc( pilha );
+
+  if( i == 0 )
+    return 0;
+  cp( noPilhaConc( pilha, i )->item, v );
+  while( !tentaEmpilharIndice( pilha, &pilha->topo, i ))
+    if( eliminaEmpilha( pilha, i ))
+      break;
+  return 1;
+}
+
+/* ----------------------------------------------------- 
+   Desempilha em *v; retorna 1 em sucesso e 0 se a pilha estiver vazia
+*/
+int desempilhaConc( PilhaConc *pilha, ItemPilha *v ){
+  uint32_t i;
+  int r;
+
+  while(( r = tentaDesempilharIndice( pilha, &pilha->topo, &i )) == -1 )
+    if( eliminaDesempilha( pilha, &i ))
+      break;
+  if( r == 0 )
+    return 0;
+  cp( *v, noPilhaConc( pilha, i )->item );
+  liberaNoPilhaConc( pilha, i );
+  return 1;
+}
+
+/* ----------------------------------------------------- */
+/* Libera todo o reservatório (sem threads usando a pilha) */
+void liberaPilhaConc( PilhaConc *pilha ){
+  int k;
+
+  for( k = 0; k < MAX_BLOCOS_PILHA; k++ ){
+    free( atomic_load( &pilha->blocos[k] ));
+    atomic_store( &pilha->blocos[k], NULL );
+  }
+  criaPilhaConc( pilha );
+}
@@ -3,15 +3,30 @@ PROGRAMA: TAD Pilha
 -----------------------------------------------------------*/
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 
 typedef char ItemPilha[50]; 
 #include "itemString.h"
 #include "pilhaVetor.h"
 
+/* ----------------------------------------------------- 
+   Com PILHA_ENCOLHE diferente de 0, o vetor cai pela metade quando
+   fica com menos de 1/4 de ocupação
+*/
+#ifndef PILHA_ENCOLHE
+#define PILHA_ENCOLHE 1
+#endif
+
 /* ----------------------------------------------------- */
 /* Função de inicialização de uma pilha vazia 
 */
 void criaPilha(Pilha *pilha){
+  pilha->item = (ItemPilha*) malloc( PILHA_CAP_INICIAL * sizeof(ItemPilha) );
+  if( pilha->item == NULL ){
+    fprintf( stderr, "Pilha: falha ao alocar %d itens\n", PILHA_CAP_INICIAL );
+    exit( 1 );
+  }
+  pilha->cap = PILHA_CAP_INICIAL;
   pilha->topo = -1;
 }
 
@@ -24,11 +39,52 @@ int pilhaVazia( Pilha p ){
     return 0;
 }
 
+/* ----------------------------------------------------- 
+   Troca a capacidade do vetor, mantendo os itens
+*/
+void realocaPilha( Pilha *p, int cap ){
+  ItemPilha *novo;
+
+  novo = (ItemPilha*) realloc( p->item, cap * sizeof(ItemPilha) );
+  if( novo == NULL ){
+    fprintf( stderr, "Pilha: falha ao alocar %d itens\n", cap );
+    exit( 1 );
+  }
+  p->item = novo;
+  p->cap = cap;
+}
+
+/* ----------------------------------------------------- 
+   Garante espaço para mais n itens, dobrando a capacidade (depois
+   de liberaPilha, cap é 0 e o vetor recomeça de PILHA_CAP_INICIAL)
+*/
+void garanteCapPilha( Pilha *p, int n ){
+  int cap = p->cap < PILHA_CAP_INICIAL ? PILHA_CAP_INICIAL : p->cap;
+
+  while( p->topo + 1 + n > cap )
+    cap *= 2;
+  if( cap != p->cap )
+    realocaPilha( p, cap );
+}
+
+/* ----------------------------------------------------- 
+   Devolve memória se a pilha ficou pouco ocupada
+*/
+void encolhePilha( Pilha *p ){
+  int cap = p->cap;
+
+  while( PILHA_ENCOLHE && cap > PILHA_CAP_INICIAL && p->topo + 1 < cap / 4 )
+    cap /= 2;
+  if( cap != p->cap )
+    realocaPilha( p, cap );
+}
+
 /* ----------------------------------------------------- 
    Empilha um novo Item 
 */
 void empilha( ItemPilha v, Pilha *p ){
-  
+  if( p->topo + 1 == p->cap )
+    garanteCapPilha( p, 1 );
   p->topo++;
   cp( p->item[p->topo],  v);
 }
@@ -38,11 +94,47 @@ void empilha( ItemPilha v, Pilha *p ){
 */
 void desempilha( Pilha *p, ItemPilha *v){
   
-  if( pilhaVazia( *p ))
+  if( pilhaVazia( *p )){
     cp( *v, ERRO );
+    return;
+  }
   cp( *v, p->item[p->topo] );
   p->topo--;
+  encolhePilha( p );
+}
+
+/* ----------------------------------------------------- 
+   Empilha os n Itens de v, na ordem (v[n-1] fica no topo)
+*/
+void empilhaLote( ItemPilha *v, int n, Pilha *p ){
+  if( n <= 0 )
+    return;
+  garanteCapPilha( p, n );
+  memcpy( p->item + p->topo + 1, v, n * sizeof(ItemPilha) );
+  p->topo += n;
 }
 
+/* ----------------------------------------------------- 
+   Desempilha até n Itens para v, na ordem em que sairiam
+   (v[0] é o antigo topo). Retorna quantos foram desempilhados
+*/
+int desempilhaLote( Pilha *p, ItemPilha *v, int n ){
+  int i;
 
+  if( n > p->topo + 1 )
+    n = p->topo + 1;
+  for( i = 0; i < n; i++ )
+    memcpy( v[i], p->item[p->topo - i], sizeof(ItemPilha) );
+  p->topo -= n;
+  encolhePilha( p );
+  return n;
+}
 
+/* ----------------------------------------------------- */
+/* Libera o vetor da pilha                               */
+void liberaPilha( Pilha *p ){
+  free( p->item );
+  p->item = NULL;
+  p->cap = 0;
+  p->topo = -1;
+}
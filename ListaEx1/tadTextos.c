@@ -0,0 +1,152 @@
+/*---------------------------------------------------------
+IMPLEMENTAÇÃO: TAD Textos
+  Os textos ficam um depois do outro em um único vetor de char que
+  cresce com realloc (por isso são identificados pela posição e não
+  por ponteiro). Uma tabela de espalhamento com sondagem linear guarda
+  posição e hash de cada texto para achar repetidos.
+-----------------------------------------------------------*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "textos.h"
+
+#define CAP_TEXTOS_INICIAL 4096
+#define CAP_TABELA_INICIAL 1024   /* potência de 2 */
+
+char *textos = NULL;
+size_t tamTextos = 0, capTextos = 0;
+
+unsigned int *posTabela = NULL;   /* 0 = vazio */
+unsigned int *hashTabela = NULL;
+size_t capTabela = 0, numTextos = 0;
+
+/* ----------------------------------------------------- */
+/* FNV-1a de 32 bits                                      */
+unsigned int hashTexto( const char *s ){
+  unsigned int h = 2166136261u;
+
+  while( *s ){
+    h ^= (unsigned char) *s++;
+    h *= 16777619u;
+  }
+  return h;
+}
+
+/* ----------------------------------------------------- */
+unsigned int prefixoTexto( const char *s ){
+  unsigned int p = 0;
+  int i;
+
+  for( i = 0; i < 4; i++ ){
+    p <<= 8;
+    if( *s )
+      p |= (unsigned char) *s++;
+  }
+  return p;
+}
+
+/* ----------------------------------------------------- 
+   Posição na tabela onde s está ou deveria estar
+*/
+size_t slotTexto( const char *s, unsigned int h ){
+  size_t i = h & (capTabela - 1);
+
+  while( posTabela[i] != 0 &&
+         ( hashTabela[i] != h || strcmp( textos + posTabela[i], s ) != 0 ))
+    i = (i + 1) & (capTabela - 1);
+  return i;
+}
+
+/* ----------------------------------------------------- 
+   Dobra a tabela e reinsere as posições (sem recalcular hashes)
+*/
+void cresceTabela( void ){
+  unsigned int *velhaPos = posTabela, *velhoHash = hashTabela;
+  size_t velhaCap = capTabela, i, j;
+
+  capTabela = velhaCap ? 2 * velhaCap : CAP_TABELA_INICIAL;
+  posTabela = (unsigned int*) calloc( capTabela, sizeof(unsigned int) );
+  hashTabela = (unsigned int*) malloc( capTabela * sizeof(unsigned int) );
+  for( i = 0; i < velhaCap; i++ )
+    if( velhaPos[i] != 0 ){
+      j = velhoHash[i] & (capTabela - 1);
+      while( posTabela[j] != 0 )
+        j = (j + 1) & (capTabela - 1);
+      posTabela[j] = velhaPos[i];
+      hashTabela[j] = velhoHash[i];
+    }
+  free( velhaPos );
+  free( velhoHash );
+}
+
+/* ----------------------------------------------------- 
+   Posição do texto s no reservatório, guardando-o se ainda não existir
+*/
+unsigned int internaTexto( const char *s ){
+  unsigned int h = hashTexto( s );
+  size_t i, tam = strlen( s ) + 1;
+
+  if( 2 * (numTextos + 1) > capTabela )
+    cresceTabela();
+  i = slotTexto( s, h );
+  if( posTabela[i] != 0 )
+    return posTabela[i];
+
+  if( tamTextos == 0 )
+    tamTextos = 1;   /* posição 0 fica reservada para "nenhum" */
+  while( tamTextos + tam > capTextos ){
+    capTextos = capTextos ? 2 * capTextos : CAP_TEXTOS_INICIAL;
+    textos = (char*) realloc( textos, capTextos );
+  }
+  memcpy( textos + tamTextos, s, tam );
+  posTabela[i] = (unsigned int) tamTextos;
+  hashTabela[i] = h;
+  tamTextos += tam;
+  numTextos++;
+  return posTabela[i];
+}
+
+/* ----------------------------------------------------- */
+/* Posição do texto s ou 0 se ele nunca foi internado     */
+unsigned int procuraTexto( const char *s ){
+  if( capTabela == 0 )
+    return 0;
+  return posTabela[slotTexto( s, hashTexto( s ))];
+}
+
+/* ----------------------------------------------------- 
+   Texto na posição pos (válido até o próximo internaTexto)
+*/
+const char *texto( unsigned int pos ){
+  return textos + pos;
+}
+
+/* ----------------------------------------------------- 
+   Compara dois textos internados (prefixo e posição de cada um),
+   com o sinal de strcmp. Só chega ao strcmp quando os 4 primeiros
+   bytes são iguais e os textos são diferentes; como um prefixo com
+   um byte zero já é o texto inteiro, o strcmp começa no 5º byte
+*/
+int comparaInternados( unsigned int prefA, unsigned int a, unsigned int prefB, unsigned int b ){
+  if( prefA != prefB )
+    return prefA < prefB ? -1 : 1;
+  if( a == b )
+    return 0;
+  return strcmp( textos + a + 4, textos + b + 4 );
+}
+
+/* ----------------------------------------------------- */
+/* Bytes ocupados pelos textos e pela tabela              */
+size_t memoriaTextos( void ){
+  return capTextos + capTabela * 2 * sizeof(unsigned int);
+}
+
+/* ----------------------------------------------------- */
+void liberaTextos( void ){
+  free( textos );
+  free( posTabela );
+  free( hashTabela );
+  textos = NULL;
+  posTabela = hashTabela = NULL;
+  tamTextos = capTextos = capTabela = numTextos = 0;
+}
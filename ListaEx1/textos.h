@@ -0,0 +1,17 @@
+/*---------------------------------------------------------
+Interface: TAD Textos (reservatório de strings internadas)
+  Cada texto distinto é guardado uma única vez e identificado pela
+  sua posição no reservatório (32 bits, 0 = nenhum): textos iguais
+  têm a mesma posição. O prefixo de um texto são os seus 4 primeiros
+  bytes em big-endian (completados com zeros), de modo que comparar
+  prefixos como inteiros dá a mesma ordem que strcmp.
+-----------------------------------------------------------*/
+#include <stddef.h>
+
+unsigned int internaTexto( const char* );
+unsigned int procuraTexto( const char* );
+const char *texto( unsigned int );
+unsigned int prefixoTexto( const char* );
+int comparaInternados( unsigned int, unsigned int, unsigned int, unsigned int );
+size_t memoriaTextos( void );
+void liberaTextos( void );
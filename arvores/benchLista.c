@@ -0,0 +1,115 @@
+// Benchmark das variantes do TAD lista
+//
+// O mesmo programa é compilado com cada implementação:
+//   gcc -O2 benchLista.c lista.c       -o bench_lista
+//   gcc -O2 benchLista.c listaBlocos.c -o bench_blocos -DVARIANTE_BLOCOS
+//   gcc -O2 benchLista.c listaSkip.c   -o bench_skip   -DVARIANTE_SKIP
+// Para medir lista.c sem reaproveitamento de itens, acrescente -DLISTA_RETENCAO=0.
+// Uso: ./bench_xxx [numero_de_itens]   (padrão: 5000000)
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <sys/resource.h>
+
+#if defined(VARIANTE_BLOCOS)
+#include "listaBlocos.h"
+#define VARIANTE "blocos (desenrolada)"
+#elif defined(VARIANTE_SKIP)
+#include "listaSkip.h"
+#define VARIANTE "skip list"
+#else
+#include "lista.h"
+#define VARIANTE "encadeada (lista.c)"
+#endif
+
+#define NUM_CONSULTAS 1000
+#define RAJADA 1000          // itens inseridos e retirados por rajada no teste de rotatividade
+
+// Tempo de relógio em milissegundos
+static double agora_ms() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1000.0 + ts.tv_nsec / 1e6;
+}
+
+// Pico de memória residente do processo, em KB
+static long memoria_pico_kb() {
+    struct rusage uso;
+    getrusage(RUSAGE_SELF, &uso);
+    return uso.ru_maxrss;
+}
+
+int main(int argc, char *argv[]) {
+    int n = (argc > 1) ? atoi(argv[1]) : 5000000;
+    struct lista_t *lst;
+    double inicio;
+    int valor;
+
+    if (n <= 0 || !(lst = lista_cria())) {
+        fprintf(stderr, "Parametros invalidos\n");
+        return 1;
+    }
+    printf("Lista %s com %d itens\n", VARIANTE, n);
+    long memoria_antes = memoria_pico_kb();
+
+    // Inserção no fim
+    inicio = agora_ms();
+    for (int i = 0; i < n; i++) {
+        lista_insere(lst, i, -1);
+    }
+    printf("  insercao no fim........: %10.2f ms\n", agora_ms() - inicio);
+    printf("  memoria (pico, aprox.).: %10ld KB (%.1f bytes/item)\n",
+           memoria_pico_kb() - memoria_antes, (memoria_pico_kb() - memoria_antes) * 1024.0 / n);
+
+    // Varredura completa: procura um valor que não está na lista
+    inicio = agora_ms();
+    int pos = lista_procura(lst, -1);
+    printf("  varredura (procura)....: %10.2f ms (%d)\n", agora_ms() - inicio, pos);
+
+#ifdef VARIANTE_SKIP
+    // Mesma varredura e procuras de valores presentes, agora pelo índice hash
+    lista_indexa_valores(lst);
+    inicio = agora_ms();
+    pos = lista_procura(lst, -1);
+    for (int i = 0; i < NUM_CONSULTAS; i++) {
+        pos = lista_procura(lst, rand() % n);
+    }
+    printf("  procura c/ indice (x%d): %10.2f ms (%d)\n", NUM_CONSULTAS + 1, agora_ms() - inicio, pos);
+#endif
+
+    // Consultas em posições aleatórias
+    srand(42);
+    long long soma = 0;
+    inicio = agora_ms();
+    for (int i = 0; i < NUM_CONSULTAS; i++) {
+        lista_consulta(lst, &valor, rand() % n);
+        soma += valor;
+    }
+    printf("  %d consultas aleatorias: %10.2f ms (soma %lld)\n", NUM_CONSULTAS, agora_ms() - inicio, soma);
+
+    // Retirada pelo início até esvaziar
+    inicio = agora_ms();
+    while (lista_tamanho(lst) > 0) {
+        lista_retira(lst, &valor, 0);
+    }
+    printf("  retirada do inicio.....: %10.2f ms\n", agora_ms() - inicio);
+
+    // Rotatividade: rajadas de inserções e retiradas no início
+    inicio = agora_ms();
+    for (int i = 0; i < n; i += 2 * RAJADA) {
+        for (int j = 0; j < RAJADA; j++) {
+            lista_insere(lst, j, 0);
+        }
+        for (int j = 0; j < RAJADA; j++) {
+            lista_retira(lst, &valor, 0);
+        }
+    }
+    printf("  rotatividade (%d ops).: %10.2f ms\n", n, agora_ms() - inicio);
+
+    lista_destroi(lst);
+#if !defined(VARIANTE_BLOCOS) && !defined(VARIANTE_SKIP)
+    lista_libera_reservas();
+#endif
+    return 0;
+}
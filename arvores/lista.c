@@ -8,6 +8,73 @@
 #include <stdlib.h>
 #include "lista.h"
 
+// Itens liberados ficam guardados em uma lista de livres (uma por thread)
+// e são reaproveitados pelas próximas inserções, até LISTA_RETENCAO itens;
+// acima disso voltam para o free(). Compilar com -DLISTA_RETENCAO=0
+// desativa o reaproveitamento.
+#ifndef LISTA_RETENCAO
+#define LISTA_RETENCAO 4096
+#endif
+
+static _Thread_local struct item_t *itens_livres = NULL;
+static _Thread_local int num_itens_livres = 0;
+
+// Obtém um item da lista de livres ou, se ela estiver vazia, do malloc.
+static struct item_t *item_aloca() {
+    struct item_t *item = itens_livres;
+
+    if (item == NULL) {
+        return malloc(sizeof(struct item_t));
+    }
+    itens_livres = item->prox;
+    num_itens_livres--;
+    return item;
+}
+
+// Devolve um item para a lista de livres ou, se ela estiver cheia, ao free.
+static void item_libera(struct item_t *item) {
+    if (num_itens_livres >= LISTA_RETENCAO) {
+        free(item);
+        return;
+    }
+    item->prox = itens_livres;
+    itens_livres = item;
+    num_itens_livres++;
+}
+
+// Devolve ao free todos os itens guardados na lista de livres da thread
+// que chama; cada thread que usou listas deve chamá-la antes de terminar.
+void lista_libera_reservas() {
+    struct item_t *item;
+
+    while (itens_livres != NULL) {
+        item = itens_livres;
+        itens_livres = item->prox;
+        free(item);
+    }
+    num_itens_livres = 0;
+}
+
+// Retorna o item na posição indicada (0 <= pos < tamanho), percorrendo a
+// lista a partir da ponta mais próxima (prim ou ult).
+static struct item_t *lista_item(struct lista_t *lst, int pos) {
+    struct item_t *atual;
+
+    if (pos < lst->tamanho / 2) {
+        atual = lst->prim;
+        for (int i = 0; i < pos; i++) {
+            atual = atual->prox;
+        }
+    }
+    else {
+        atual = lst->ult;
+        for (int i = lst->tamanho - 1; i > pos; i--) {
+            atual = atual->ant;
+        }
+    }
+    return atual;
+}
+
 struct lista_t *lista_cria (){
     struct lista_t *lista;
     if(!(lista = malloc(sizeof(struct lista_t)))) {
@@ -34,7 +101,7 @@ struct lista_t *lista_destroi(struct lista_t *lst) {
         lst->prim = lst->prim->prox;
 
         // Libera o atual
-        free(aux);
+        item_libera(aux);
     }
 
     //libera a struct lista
@@ -52,7 +119,7 @@ int lista_insere(struct lista_t *lst, int item, int pos) {
     }
 
     // Tenta alocar memoria para um novo item
-    if (!(novo = malloc(sizeof(struct item_t)))) {
+    if (!(novo = item_aloca())) {
         return -1;
     }
 
@@ -78,11 +145,8 @@ int lista_insere(struct lista_t *lst, int item, int pos) {
         lst->ult = novo;
     }
     else {
-        // Insere em uma posição especifica
-        struct item_t *atual = lst->prim;
-        for (int i = 0; i < pos - 1; i++) {
-            atual = atual->prox;
-        }
+        // Insere em uma posição especifica, logo após o item pos-1
+        struct item_t *atual = lista_item(lst, pos - 1);
         novo->prox = atual->prox;
         novo->ant = atual;
         if (atual->prox) {
@@ -103,8 +167,6 @@ int lista_retira(struct lista_t *lst, int *item, int pos) {
 
     struct item_t *atual;
 
-    lst->tamanho--;
-    
     // Remover do início da lista
     if (pos == 0) {
         atual = lst->prim;
@@ -115,7 +177,8 @@ int lista_retira(struct lista_t *lst, int *item, int pos) {
         } else {
             lst->ult = NULL;  // Lista fica vazia
         }
-        free(atual);
+        item_libera(atual);
+        lst->tamanho--;
         return lst->tamanho;
     }
 
@@ -129,21 +192,22 @@ int lista_retira(struct lista_t *lst, int *item, int pos) {
         } else {
             lst->prim = NULL;  // Lista fica vazia
         }
-        free(atual);
+        item_libera(atual);
+        lst->tamanho--;
         return lst->tamanho;
     }
 
     // Remover de uma posição específica
-    atual = lst->prim;
-    for (int i = 0; i < pos; i++) {
-        atual = atual->prox;
-    }
+    atual = lista_item(lst, pos);
     *item = atual->valor;
     atual->ant->prox = atual->prox;
     if (atual->prox) {
         atual->prox->ant = atual->ant;
+    } else {
+        lst->ult = atual->ant;  // Era o último item
     }
-    free(atual);
+    item_libera(atual);
+    lst->tamanho--;
     return lst->tamanho;
 }
 
@@ -162,10 +226,7 @@ int lista_consulta(struct lista_t *lst, int *item, int pos) {
         return -1;
     }
     else {
-        a = lst->prim;
-        for (int i = 0; i < pos; i++) {
-            a = a->prox;
-        }
+        a = lista_item(lst, pos);
     }
     *item = a->valor;
     return lst->tamanho;
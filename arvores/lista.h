@@ -60,4 +60,9 @@ int lista_tamanho (struct lista_t *lst);
 // com um espaço entre itens, sem espaços antes/depois, sem newline.
 void lista_imprime (struct lista_t *lst);
 
+// Fora da interface original: libera os itens que esta implementação
+// guarda para reaproveitar (uma reserva por thread). Chamar antes de a
+// thread (ou o programa) terminar.
+void lista_libera_reservas ();
+
 #endif
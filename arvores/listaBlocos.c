@@ -0,0 +1,259 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include "listaBlocos.h"
+
+// Aloca um bloco vazio alinhado à linha de cache.
+static struct bloco_t *bloco_cria() {
+    struct bloco_t *novo;
+
+    if (!(novo = aligned_alloc(LINHA_CACHE, sizeof(struct bloco_t)))) {
+        return NULL;
+    }
+    novo->ant = NULL;
+    novo->prox = NULL;
+    novo->quantidade = 0;
+    return novo;
+}
+
+// Encontra o bloco que contém a posição pos (0 <= pos <= tamanho),
+// percorrendo a partir da ponta mais próxima. Em *desloc fica a posição
+// dentro do bloco; pos == tamanho resulta no fim do último bloco.
+static struct bloco_t *localiza(struct lista_t *lst, int pos, int *desloc) {
+    struct bloco_t *atual;
+
+    if (pos < lst->tamanho / 2) {
+        atual = lst->prim;
+        while (pos >= atual->quantidade && atual->prox != NULL) {
+            pos -= atual->quantidade;
+            atual = atual->prox;
+        }
+    }
+    else {
+        // Conta de trás para frente quantos itens ficam depois de pos
+        int depois = lst->tamanho - pos;
+        atual = lst->ult;
+        while (depois > atual->quantidade) {
+            depois -= atual->quantidade;
+            atual = atual->ant;
+        }
+        pos = atual->quantidade - depois;
+    }
+    *desloc = pos;
+    return atual;
+}
+
+// Divide um bloco cheio, movendo os valores a partir de metade para um
+// novo bloco logo depois dele. Retorno: o novo bloco ou NULL em erro.
+static struct bloco_t *bloco_divide(struct lista_t *lst, struct bloco_t *bloco, int metade) {
+    struct bloco_t *novo;
+
+    if (!(novo = bloco_cria())) {
+        return NULL;
+    }
+    for (int i = metade; i < bloco->quantidade; i++) {
+        novo->valores[i - metade] = bloco->valores[i];
+    }
+    novo->quantidade = bloco->quantidade - metade;
+    bloco->quantidade = metade;
+
+    novo->ant = bloco;
+    novo->prox = bloco->prox;
+    if (bloco->prox) {
+        bloco->prox->ant = novo;
+    } else {
+        lst->ult = novo;
+    }
+    bloco->prox = novo;
+    return novo;
+}
+
+// Retira um bloco do encadeamento e libera sua memória.
+static void bloco_remove(struct lista_t *lst, struct bloco_t *bloco) {
+    if (bloco->ant) {
+        bloco->ant->prox = bloco->prox;
+    } else {
+        lst->prim = bloco->prox;
+    }
+    if (bloco->prox) {
+        bloco->prox->ant = bloco->ant;
+    } else {
+        lst->ult = bloco->ant;
+    }
+    free(bloco);
+}
+
+struct lista_t *lista_cria() {
+    struct lista_t *lista;
+
+    if (!(lista = malloc(sizeof(struct lista_t)))) {
+        return NULL;
+    }
+    lista->prim = NULL;
+    lista->ult = NULL;
+    lista->tamanho = 0;
+    return lista;
+}
+
+struct lista_t *lista_destroi(struct lista_t *lst) {
+    if (lst == NULL) {
+        return NULL;
+    }
+
+    struct bloco_t *aux;
+    while (lst->prim != NULL) {
+        aux = lst->prim;
+        lst->prim = lst->prim->prox;
+        free(aux);
+    }
+    free(lst);
+    return NULL;
+}
+
+int lista_insere(struct lista_t *lst, int item, int pos) {
+    struct bloco_t *bloco;
+    int desloc;
+
+    if (lst == NULL) {
+        return -1;
+    }
+
+    // Insere no final se pos é -1 ou maior que o último índice
+    if (pos < 0 || pos > lst->tamanho) {
+        pos = lst->tamanho;
+    }
+
+    // Lista vazia: cria o primeiro bloco
+    if (lst->prim == NULL) {
+        if (!(lst->prim = bloco_cria())) {
+            return -1;
+        }
+        lst->ult = lst->prim;
+    }
+
+    bloco = localiza(lst, pos, &desloc);
+
+    // Bloco cheio: divide e escolhe a metade onde o item entra. No fim da
+    // lista apenas abre um bloco vazio, para inserções no fim manterem os
+    // blocos cheios em vez de pela metade.
+    if (bloco->quantidade == (int)BLOCO_CAPACIDADE) {
+        int metade = (bloco == lst->ult && desloc == bloco->quantidade) ? bloco->quantidade : bloco->quantidade / 2;
+        struct bloco_t *novo = bloco_divide(lst, bloco, metade);
+        if (novo == NULL) {
+            return -1;
+        }
+        if (desloc > bloco->quantidade || (desloc == bloco->quantidade && novo->quantidade == 0)) {
+            desloc -= bloco->quantidade;
+            bloco = novo;
+        }
+    }
+
+    // Abre espaço dentro do bloco
+    for (int i = bloco->quantidade; i > desloc; i--) {
+        bloco->valores[i] = bloco->valores[i - 1];
+    }
+    bloco->valores[desloc] = item;
+    bloco->quantidade++;
+
+    lst->tamanho++;
+    return lst->tamanho;
+}
+
+int lista_retira(struct lista_t *lst, int *item, int pos) {
+    struct bloco_t *bloco;
+    int desloc;
+
+    if (lst == NULL || item == NULL || lst->tamanho == 0 || pos < -1 || pos >= lst->tamanho) {
+        return -1;
+    }
+
+    // Retira do fim se pos é -1
+    if (pos == -1) {
+        pos = lst->tamanho - 1;
+    }
+
+    bloco = localiza(lst, pos, &desloc);
+    *item = bloco->valores[desloc];
+    for (int i = desloc; i < bloco->quantidade - 1; i++) {
+        bloco->valores[i] = bloco->valores[i + 1];
+    }
+    bloco->quantidade--;
+    lst->tamanho--;
+
+    if (bloco->quantidade == 0) {
+        bloco_remove(lst, bloco);
+    }
+    // Junta com o próximo bloco quando os dois cabem em um só, para os
+    // blocos não ficarem esparsos depois de muitas remoções
+    else if (bloco->prox != NULL && bloco->quantidade + bloco->prox->quantidade <= (int)BLOCO_CAPACIDADE / 2) {
+        struct bloco_t *prox = bloco->prox;
+        for (int i = 0; i < prox->quantidade; i++) {
+            bloco->valores[bloco->quantidade + i] = prox->valores[i];
+        }
+        bloco->quantidade += prox->quantidade;
+        bloco_remove(lst, prox);
+    }
+
+    return lst->tamanho;
+}
+
+int lista_consulta(struct lista_t *lst, int *item, int pos) {
+    struct bloco_t *bloco;
+    int desloc;
+
+    if (lst == NULL || item == NULL || lst->tamanho == 0 || pos < -1 || pos >= lst->tamanho) {
+        return -1;
+    }
+
+    // Consulta do fim se pos é -1
+    if (pos == -1) {
+        pos = lst->tamanho - 1;
+    }
+
+    bloco = localiza(lst, pos, &desloc);
+    *item = bloco->valores[desloc];
+    return lst->tamanho;
+}
+
+int lista_procura(struct lista_t *lst, int valor) {
+    if (lst == NULL) {
+        return -1;
+    }
+
+    int pos = 0;
+
+    // Percorre os blocos; dentro de cada um os valores são contíguos
+    for (struct bloco_t *atual = lst->prim; atual != NULL; atual = atual->prox) {
+        for (int i = 0; i < atual->quantidade; i++) {
+            if (atual->valores[i] == valor) {
+                return pos + i;
+            }
+        }
+        pos += atual->quantidade;
+    }
+
+    // Retorna -1 se o valor não for encontrado
+    return -1;
+}
+
+int lista_tamanho(struct lista_t *lst) {
+    if (lst == NULL) {
+        return -1;
+    }
+
+    return lst->tamanho;
+}
+
+void lista_imprime(struct lista_t *lst) {
+    // Verifica se a lista está vazia
+    if (lst == NULL || lst->tamanho == 0) {
+        return;
+    }
+
+    const char *separador = "";
+    for (struct bloco_t *atual = lst->prim; atual != NULL; atual = atual->prox) {
+        for (int i = 0; i < atual->quantidade; i++) {
+            printf("%s%d", separador, atual->valores[i]);
+            separador = " ";
+        }
+    }
+}
@@ -0,0 +1,73 @@
+// TAD lista de números inteiros - variante desenrolada (em blocos)
+//
+// Mesma interface de lista.h; muda apenas a representação. Em vez de um
+// item por malloc, cada bloco guarda até BLOCO_CAPACIDADE valores
+// contíguos e ocupa exatamente BLOCO_BYTES, alinhado à linha de cache.
+// Para usar, inclua este arquivo no lugar de lista.h e compile com
+// listaBlocos.c no lugar de lista.c.
+
+#ifndef LISTA_BLOCOS
+#define LISTA_BLOCOS
+
+#define LINHA_CACHE 64		// alinhamento dos blocos, em bytes
+#define BLOCO_BYTES 256		// tamanho de um bloco (múltiplo de LINHA_CACHE)
+
+// quantos valores cabem em um bloco depois dos ponteiros e do contador
+#define BLOCO_CAPACIDADE ((BLOCO_BYTES - 2 * sizeof (void *) - sizeof (int)) / sizeof (int))
+
+// estrutura de um bloco da lista
+struct bloco_t
+{
+  struct bloco_t *ant ;		// bloco anterior
+  struct bloco_t *prox ;	// próximo bloco
+  int quantidade ;		// número de valores usados no bloco
+  int valores[BLOCO_CAPACIDADE] ;	// valores, em ordem
+} ;
+
+// estrutura de uma lista
+struct lista_t
+{
+  struct bloco_t *prim ;	// primeiro bloco
+  struct bloco_t *ult ;		// último bloco
+  int tamanho ;		// número de itens da lista
+} ;
+
+// Cria uma lista vazia.
+// Retorno: ponteiro p/ a lista ou NULL em erro.
+struct lista_t *lista_cria ();
+
+// Remove todos os itens da lista e libera a memória.
+// Retorno: NULL.
+struct lista_t *lista_destroi (struct lista_t *lst);
+
+// Nas operações insere/retira/consulta/procura, a lista inicia na
+// posição 0 (primeiro item) e termina na posição TAM-1 (último item).
+
+// Insere o item na lista na posição indicada;
+// se a posição for além do fim da lista ou for -1, insere no fim.
+// Retorno: número de itens na lista após a operação ou -1 em erro.
+int lista_insere (struct lista_t *lst, int item, int pos);
+
+// Retira o item da lista da posição indicada.
+// se a posição for -1, retira do fim.
+// Retorno: número de itens na lista após a operação ou -1 em erro.
+int lista_retira (struct lista_t *lst, int *item, int pos);
+
+// Informa o valor do item na posição indicada, sem retirá-lo.
+// se a posição for -1, consulta do fim.
+// Retorno: número de itens na lista ou -1 em erro.
+int lista_consulta (struct lista_t *lst, int *item, int pos);
+
+// Informa a posição da 1ª ocorrência do valor indicado na lista.
+// Retorno: posição do valor ou -1 se não encontrar ou erro.
+int lista_procura (struct lista_t *lst, int valor);
+
+// Informa o tamanho da lista (o número de itens presentes nela).
+// Retorno: número de itens na lista ou -1 em erro.
+int lista_tamanho (struct lista_t *lst);
+
+// Imprime o conteúdo da lista do inicio ao fim no formato "item item ...",
+// com um espaço entre itens, sem espaços antes/depois, sem newline.
+void lista_imprime (struct lista_t *lst);
+
+#endif
@@ -0,0 +1,447 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include "listaSkip.h"
+
+// Posições internas: a cabeça está na posição -1 e o fim da lista
+// (prox == NULL) na posição tamanho. A largura de uma ligação é a
+// diferença entre as posições das suas pontas.
+
+#define INDICE_BALDES_INICIAL 64	// baldes do índice de valores ao ser criado
+
+// Espalha o valor pelos baldes (hash multiplicativo de Knuth). Usa os
+// bits altos do produto: os baixos dependem só dos bits baixos do valor,
+// e múltiplos de 2^k cairiam em num_baldes/2^k baldes.
+static unsigned int indice_hash(int valor, int num_baldes) {
+    int bits = __builtin_ctz((unsigned int)num_baldes); // num_baldes = 2^bits >= 64
+    return ((unsigned int)valor * 2654435761u) >> (32 - bits);
+}
+
+// Procura a entrada do valor no índice.
+// Retorno: ponteiro para o campo que aponta para a entrada (para permitir
+// retirá-la do balde); *resultado é NULL se o valor não está indexado.
+static struct ocorrencias_t **indice_entrada(struct indice_t *ind, int valor) {
+    struct ocorrencias_t **atual = &ind->baldes[indice_hash(valor, ind->num_baldes)];
+    while (*atual != NULL && (*atual)->valor != valor) {
+        atual = &(*atual)->prox;
+    }
+    return atual;
+}
+
+// Dobra o número de baldes quando há mais entradas que baldes.
+// Retorno: 0 em sucesso ou -1 em erro (o índice continua válido).
+static int indice_expande(struct indice_t *ind) {
+    int novo_num = ind->num_baldes * 2;
+    struct ocorrencias_t **novos = calloc(novo_num, sizeof(struct ocorrencias_t *));
+    if (!novos) {
+        return -1;
+    }
+    for (int b = 0; b < ind->num_baldes; b++) {
+        struct ocorrencias_t *atual = ind->baldes[b];
+        while (atual != NULL) {
+            struct ocorrencias_t *prox = atual->prox;
+            unsigned int h = indice_hash(atual->valor, novo_num);
+            atual->prox = novos[h];
+            novos[h] = atual;
+            atual = prox;
+        }
+    }
+    free(ind->baldes);
+    ind->baldes = novos;
+    ind->num_baldes = novo_num;
+    return 0;
+}
+
+// Quantos itens de ent estão antes da posição pos: busca binária em
+// itens[], que fica em ordem de posição, calculando a posição só dos
+// itens consultados.
+static int indice_antes_de(struct lista_t *lst, struct ocorrencias_t *ent, int pos) {
+    int ini = 0, fim = ent->quantidade;
+
+    while (ini < fim) {
+        int meio = ini + (fim - ini) / 2;
+        if (lista_posicao_item(lst, ent->itens[meio]) < pos) {
+            ini = meio + 1;
+        }
+        else {
+            fim = meio;
+        }
+    }
+    return ini;
+}
+
+// Registra no índice o item que vai ocupar a posição pos (ainda não
+// ligado à lista), ou que já é o último da lista se pos é -1.
+// Retorno: 0 em sucesso ou -1 em erro.
+static int indice_adiciona(struct lista_t *lst, struct indice_t *ind, struct item_t *item, int pos) {
+    struct ocorrencias_t **lugar = indice_entrada(ind, item->valor);
+    struct ocorrencias_t *ent = *lugar;
+
+    if (ent == NULL) {
+        if (!(ent = malloc(sizeof(struct ocorrencias_t)))) {
+            return -1;
+        }
+        ent->valor = item->valor;
+        ent->quantidade = 0;
+        ent->capacidade = 0;
+        ent->itens = NULL;
+        ent->prox = NULL;
+        *lugar = ent;
+        ind->num_entradas++;
+    }
+    if (ent->quantidade == ent->capacidade) {
+        int nova_cap = ent->capacidade ? ent->capacidade * 2 : 2;
+        struct item_t **novos = realloc(ent->itens, nova_cap * sizeof(struct item_t *));
+        if (!novos) {
+            return -1;
+        }
+        ent->itens = novos;
+        ent->capacidade = nova_cap;
+    }
+    // Os itens que estão antes de pos continuam antes; os outros andam uma posição
+    int i = pos < 0 ? ent->quantidade : indice_antes_de(lst, ent, pos);
+    for (int j = ent->quantidade; j > i; j--) {
+        ent->itens[j] = ent->itens[j - 1];
+    }
+    ent->itens[i] = item;
+    ent->quantidade++;
+
+    if (ind->num_entradas > ind->num_baldes) {
+        indice_expande(ind);
+    }
+    return 0;
+}
+
+// Retira do índice o item da posição pos (ainda ligado à lista),
+// descartando a entrada se ela ficar vazia.
+static void indice_remove(struct lista_t *lst, struct indice_t *ind, struct item_t *item, int pos) {
+    struct ocorrencias_t **lugar = indice_entrada(ind, item->valor);
+    struct ocorrencias_t *ent = *lugar;
+
+    if (ent == NULL) {
+        return;
+    }
+    int i = indice_antes_de(lst, ent, pos);
+    if (i < ent->quantidade && ent->itens[i] == item) {
+        ent->quantidade--;
+        for (; i < ent->quantidade; i++) {
+            ent->itens[i] = ent->itens[i + 1];
+        }
+    }
+    if (ent->quantidade == 0) {
+        *lugar = ent->prox;
+        free(ent->itens);
+        free(ent);
+        ind->num_entradas--;
+    }
+}
+
+// Libera o índice e todas as suas entradas.
+static void indice_destroi(struct indice_t *ind) {
+    if (ind == NULL) {
+        return;
+    }
+    for (int b = 0; b < ind->num_baldes; b++) {
+        while (ind->baldes[b] != NULL) {
+            struct ocorrencias_t *aux = ind->baldes[b];
+            ind->baldes[b] = aux->prox;
+            free(aux->itens);
+            free(aux);
+        }
+    }
+    free(ind->baldes);
+    free(ind);
+}
+
+// Aloca um item com o número de níveis indicado.
+static struct item_t *item_cria(int valor, int nivel) {
+    struct item_t *novo;
+
+    novo = malloc(sizeof(struct item_t) + nivel * sizeof(struct nivel_t));
+    if (!novo) {
+        return NULL;
+    }
+    novo->valor = valor;
+    novo->nivel = nivel;
+    return novo;
+}
+
+// Sorteia o nível de um novo item: cada nível extra tem chance 1/4.
+static int sorteia_nivel() {
+    int nivel = 1;
+    while (nivel < SKIP_MAX_NIVEL && (rand() & 3) == 0) {
+        nivel++;
+    }
+    return nivel;
+}
+
+// Desce pelos níveis até o item imediatamente anterior à posição pos,
+// guardando em ant[] o último item visitado em cada nível e em
+// pos_ant[] a posição dele.
+static void localiza(struct lista_t *lst, int pos, struct item_t **ant, int *pos_ant) {
+    struct item_t *atual = lst->cabeca;
+    int atual_pos = -1;
+
+    for (int n = lst->nivel - 1; n >= 0; n--) {
+        while (atual->niveis[n].prox != NULL && atual_pos + atual->niveis[n].largura < pos) {
+            atual_pos += atual->niveis[n].largura;
+            atual = atual->niveis[n].prox;
+        }
+        ant[n] = atual;
+        pos_ant[n] = atual_pos;
+    }
+}
+
+struct lista_t *lista_cria() {
+    struct lista_t *lista;
+
+    if (!(lista = malloc(sizeof(struct lista_t)))) {
+        return NULL;
+    }
+    if (!(lista->cabeca = item_cria(0, SKIP_MAX_NIVEL))) {
+        free(lista);
+        return NULL;
+    }
+    for (int n = 0; n < SKIP_MAX_NIVEL; n++) {
+        lista->cabeca->niveis[n].prox = NULL;
+        lista->cabeca->niveis[n].ant = NULL;
+        lista->cabeca->niveis[n].largura = 1;
+    }
+    lista->nivel = 1;
+    lista->tamanho = 0;
+    lista->indice = NULL;
+    return lista;
+}
+
+struct lista_t *lista_destroi(struct lista_t *lst) {
+    if (lst == NULL) {
+        return NULL;
+    }
+
+    // O nível 0 passa por todos os itens
+    struct item_t *atual = lst->cabeca;
+    while (atual != NULL) {
+        struct item_t *aux = atual;
+        atual = atual->niveis[0].prox;
+        free(aux);
+    }
+    indice_destroi(lst->indice);
+    free(lst);
+    return NULL;
+}
+
+int lista_insere(struct lista_t *lst, int item, int pos) {
+    struct item_t *ant[SKIP_MAX_NIVEL];
+    int pos_ant[SKIP_MAX_NIVEL];
+    struct item_t *novo;
+
+    if (lst == NULL) {
+        return -1;
+    }
+
+    // Insere no final se pos é -1 ou maior que o último índice
+    if (pos < 0 || pos > lst->tamanho) {
+        pos = lst->tamanho;
+    }
+
+    int nivel = sorteia_nivel();
+    if (!(novo = item_cria(item, nivel))) {
+        return -1;
+    }
+    if (lst->indice != NULL && indice_adiciona(lst, lst->indice, novo, pos == lst->tamanho ? -1 : pos) < 0) {
+        free(novo);
+        return -1;
+    }
+
+    // Níveis que passam a ser usados começam vazios na cabeça
+    while (lst->nivel < nivel) {
+        lst->cabeca->niveis[lst->nivel].prox = NULL;
+        lst->cabeca->niveis[lst->nivel].largura = lst->tamanho + 1;
+        lst->nivel++;
+    }
+
+    localiza(lst, pos, ant, pos_ant);
+
+    for (int n = 0; n < lst->nivel; n++) {
+        if (n < nivel) {
+            // Divide a ligação ant[n] -> prox em ant[n] -> novo -> prox
+            novo->niveis[n].prox = ant[n]->niveis[n].prox;
+            novo->niveis[n].ant = ant[n];
+            novo->niveis[n].largura = ant[n]->niveis[n].largura - (pos - pos_ant[n]) + 1;
+            if (novo->niveis[n].prox != NULL) {
+                novo->niveis[n].prox->niveis[n].ant = novo;
+            }
+            ant[n]->niveis[n].prox = novo;
+            ant[n]->niveis[n].largura = pos - pos_ant[n];
+        }
+        else {
+            // A ligação passa por cima do novo item
+            ant[n]->niveis[n].largura++;
+        }
+    }
+
+    lst->tamanho++;
+    return lst->tamanho;
+}
+
+int lista_retira(struct lista_t *lst, int *item, int pos) {
+    struct item_t *ant[SKIP_MAX_NIVEL];
+    int pos_ant[SKIP_MAX_NIVEL];
+
+    if (lst == NULL || item == NULL || lst->tamanho == 0 || pos < -1 || pos >= lst->tamanho) {
+        return -1;
+    }
+
+    // Retira do fim se pos é -1
+    if (pos == -1) {
+        pos = lst->tamanho - 1;
+    }
+
+    localiza(lst, pos, ant, pos_ant);
+    struct item_t *alvo = ant[0]->niveis[0].prox;
+    if (lst->indice != NULL) {
+        indice_remove(lst, lst->indice, alvo, pos);
+    }
+
+    for (int n = 0; n < lst->nivel; n++) {
+        if (ant[n]->niveis[n].prox == alvo) {
+            // Junta as ligações ant[n] -> alvo -> prox
+            ant[n]->niveis[n].largura += alvo->niveis[n].largura - 1;
+            ant[n]->niveis[n].prox = alvo->niveis[n].prox;
+            if (alvo->niveis[n].prox != NULL) {
+                alvo->niveis[n].prox->niveis[n].ant = ant[n];
+            }
+        }
+        else {
+            ant[n]->niveis[n].largura--;
+        }
+    }
+    *item = alvo->valor;
+    free(alvo);
+
+    // Descarta níveis que ficaram vazios
+    while (lst->nivel > 1 && lst->cabeca->niveis[lst->nivel - 1].prox == NULL) {
+        lst->nivel--;
+    }
+
+    lst->tamanho--;
+    return lst->tamanho;
+}
+
+int lista_consulta(struct lista_t *lst, int *item, int pos) {
+    struct item_t *ant[SKIP_MAX_NIVEL];
+    int pos_ant[SKIP_MAX_NIVEL];
+
+    if (lst == NULL || item == NULL || lst->tamanho == 0 || pos < -1 || pos >= lst->tamanho) {
+        return -1;
+    }
+
+    // Consulta do fim se pos é -1
+    if (pos == -1) {
+        pos = lst->tamanho - 1;
+    }
+
+    localiza(lst, pos, ant, pos_ant);
+    *item = ant[0]->niveis[0].prox->valor;
+    return lst->tamanho;
+}
+
+int lista_procura(struct lista_t *lst, int valor) {
+    if (lst == NULL) {
+        return -1;
+    }
+
+    // Com o índice, a 1ª ocorrência é o primeiro dos itens com o valor
+    if (lst->indice != NULL) {
+        struct ocorrencias_t *ent = *indice_entrada(lst->indice, valor);
+        return ent != NULL ? lista_posicao_item(lst, ent->itens[0]) : -1;
+    }
+
+    struct item_t *atual = lst->cabeca->niveis[0].prox;
+    int pos = 0;
+
+    // Percorre o nível 0 em busca do valor
+    while (atual != NULL) {
+        if (atual->valor == valor) {
+            return pos;
+        }
+        atual = atual->niveis[0].prox;
+        pos++;
+    }
+
+    // Retorna -1 se o valor não for encontrado
+    return -1;
+}
+
+int lista_tamanho(struct lista_t *lst) {
+    if (lst == NULL) {
+        return -1;
+    }
+
+    return lst->tamanho;
+}
+
+void lista_imprime(struct lista_t *lst) {
+    // Verifica se a lista está vazia
+    if (lst == NULL || lst->tamanho == 0) {
+        return;
+    }
+
+    struct item_t *atual = lst->cabeca->niveis[0].prox;
+
+    // Imprime o primeiro item
+    printf("%d", atual->valor);
+    atual = atual->niveis[0].prox;
+
+    // Imprime o resto
+    while (atual != NULL) {
+        printf(" %d", atual->valor);
+        atual = atual->niveis[0].prox;
+    }
+}
+
+int lista_indexa_valores(struct lista_t *lst) {
+    if (lst == NULL) {
+        return -1;
+    }
+    if (lst->indice != NULL) {
+        return 1;
+    }
+
+    struct indice_t *ind = malloc(sizeof(struct indice_t));
+    if (!ind) {
+        return -1;
+    }
+    ind->num_baldes = INDICE_BALDES_INICIAL;
+    ind->num_entradas = 0;
+    if (!(ind->baldes = calloc(ind->num_baldes, sizeof(struct ocorrencias_t *)))) {
+        free(ind);
+        return -1;
+    }
+
+    for (struct item_t *atual = lst->cabeca->niveis[0].prox; atual != NULL; atual = atual->niveis[0].prox) {
+        if (indice_adiciona(lst, ind, atual, -1) < 0) {
+            indice_destroi(ind);
+            return -1;
+        }
+    }
+    lst->indice = ind;
+    return 1;
+}
+
+int lista_posicao_item(struct lista_t *lst, struct item_t *item) {
+    if (lst == NULL || item == NULL) {
+        return -1;
+    }
+
+    // Volta até a cabeça sempre pelo nível mais alto do item atual,
+    // somando as larguras das ligações percorridas
+    int pos = -1;
+    struct item_t *atual = item;
+    while (atual != lst->cabeca) {
+        int n = atual->nivel - 1;
+        struct item_t *ant = atual->niveis[n].ant;
+        pos += ant->niveis[n].largura;
+        atual = ant;
+    }
+    return pos;
+}
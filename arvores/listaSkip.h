@@ -0,0 +1,111 @@
+// TAD lista de números inteiros - variante indexável (skip list)
+//
+// Mesma interface de lista.h; muda apenas a representação. Cada item
+// guarda, em cada nível, quantas posições o seu sucessor daquele nível
+// está à frente, o que permite localizar uma posição em O(log n)
+// esperado. Para usar, inclua este arquivo no lugar de lista.h e compile
+// com listaSkip.c no lugar de lista.c.
+//
+// Opcionalmente (lista_indexa_valores) a lista mantém um índice hash
+// valor -> itens com esse valor, e lista_procura deixa de percorrer a
+// lista: os itens de cada valor ficam em ordem de posição, e a posição
+// do primeiro é calculada subindo pelos níveis, em O(log n) esperado.
+
+#ifndef LISTA_SKIP
+#define LISTA_SKIP
+
+#define SKIP_MAX_NIVEL 32	// número máximo de níveis de um item
+
+// ligação de um item em um nível da skip list
+struct nivel_t
+{
+  struct item_t *prox ;	// próximo item neste nível
+  struct item_t *ant ;	// item anterior neste nível
+  int largura ;		// quantas posições o próximo item está à frente
+} ;
+
+// conjunto de itens que têm um mesmo valor (entrada do índice hash)
+struct ocorrencias_t
+{
+  int valor ;			// valor indexado
+  int quantidade ;		// número de itens com o valor
+  int capacidade ;		// tamanho alocado de itens[]
+  struct item_t **itens ;	// itens com o valor, em ordem de posição
+  struct ocorrencias_t *prox ;	// próxima entrada no mesmo balde
+} ;
+
+// índice hash valor -> ocorrências, com encadeamento separado
+struct indice_t
+{
+  struct ocorrencias_t **baldes ;	// vetor de listas de entradas
+  int num_baldes ;		// tamanho de baldes[] (potência de 2)
+  int num_entradas ;		// valores distintos indexados
+} ;
+
+// estrutura de um item da lista
+struct item_t
+{
+  int valor ;			// valor do item
+  int nivel ;			// número de níveis deste item
+  struct nivel_t niveis[] ;	// ligações, do nível 0 (todos os itens) para cima
+} ;
+
+// estrutura de uma lista
+struct lista_t
+{
+  struct item_t *cabeca ;	// sentinela com SKIP_MAX_NIVEL níveis (antes da posição 0)
+  int nivel ;			// número de níveis em uso
+  int tamanho ;		// número de itens da lista
+  struct indice_t *indice ;	// índice de valores ou NULL se desativado
+} ;
+
+// Cria uma lista vazia.
+// Retorno: ponteiro p/ a lista ou NULL em erro.
+struct lista_t *lista_cria ();
+
+// Remove todos os itens da lista e libera a memória.
+// Retorno: NULL.
+struct lista_t *lista_destroi (struct lista_t *lst);
+
+// Nas operações insere/retira/consulta/procura, a lista inicia na
+// posição 0 (primeiro item) e termina na posição TAM-1 (último item).
+
+// Insere o item na lista na posição indicada;
+// se a posição for além do fim da lista ou for -1, insere no fim.
+// Retorno: número de itens na lista após a operação ou -1 em erro.
+int lista_insere (struct lista_t *lst, int item, int pos);
+
+// Retira o item da lista da posição indicada.
+// se a posição for -1, retira do fim.
+// Retorno: número de itens na lista após a operação ou -1 em erro.
+int lista_retira (struct lista_t *lst, int *item, int pos);
+
+// Informa o valor do item na posição indicada, sem retirá-lo.
+// se a posição for -1, consulta do fim.
+// Retorno: número de itens na lista ou -1 em erro.
+int lista_consulta (struct lista_t *lst, int *item, int pos);
+
+// Informa a posição da 1ª ocorrência do valor indicado na lista.
+// Retorno: posição do valor ou -1 se não encontrar ou erro.
+int lista_procura (struct lista_t *lst, int valor);
+
+// Informa o tamanho da lista (o número de itens presentes nela).
+// Retorno: número de itens na lista ou -1 em erro.
+int lista_tamanho (struct lista_t *lst);
+
+// Imprime o conteúdo da lista do inicio ao fim no formato "item item ...",
+// com um espaço entre itens, sem espaços antes/depois, sem newline.
+void lista_imprime (struct lista_t *lst);
+
+// Extensões desta variante ------------------------------------------
+
+// Cria o índice de valores a partir do conteúdo atual; daí em diante ele
+// é mantido por lista_insere/lista_retira e usado por lista_procura.
+// Retorno: 1 se o índice está ativo ou -1 em erro.
+int lista_indexa_valores (struct lista_t *lst);
+
+// Informa a posição de um item da lista, em O(log n) esperado.
+// Retorno: posição do item ou -1 em erro.
+int lista_posicao_item (struct lista_t *lst, struct item_t *item);
+
+#endif
@@ -5,6 +5,26 @@
 #include "Carro.h"
 
 #define MAX_ORDER 1000
+#define MAX_NIVEIS 64 // Limite de níveis acompanhados pelas estatísticas (bem acima do necessário).
+#define TAMANHO_BUFFER_INSERCOES 64 // Mensagens acumuladas em um nó interno antes de descê-las.
+
+/**
+ * @brief Uma inserção pendente, guardada no buffer de um nó interno.
+ */
+typedef struct {
+    int chave;
+    Carro *carro;
+} MensagemInsercao;
+
+/**
+ * @brief Buffer de inserções pendentes de um nó interno (modo com buffers, estilo Bε-tree).
+ * As mensagens ficam em ordem de chegada; as mais antigas vêm primeiro.
+ */
+typedef struct BufferInsercoes {
+    int quantidade;
+    int capacidade;
+    MensagemInsercao *mensagens;
+} BufferInsercoes;
 
 typedef struct No {
     bool folha;
@@ -13,14 +33,58 @@ typedef struct No {
     void *ponteiros[MAX_ORDER + 1];
     struct No *prox_folha;
     struct No *pai;
+    BufferInsercoes *buffer; // Só em nós internos e com `buffer_insercoes` ativo; NULL caso contrário.
 } No;
 
+/**
+ * @brief Define o que `inserir()` faz quando a chave já existe na árvore.
+ */
+typedef enum {
+    DUPLICATAS_PERMITIR,   // Insere outra entrada com a mesma chave (comportamento original).
+    DUPLICATAS_REJEITAR,   // Mantém o valor antigo e descarta o novo.
+    DUPLICATAS_SUBSTITUIR, // Upsert: troca o valor antigo pelo novo no próprio nó folha.
+    DUPLICATAS_LISTA       // Guarda todos os valores da chave em uma lista de ocorrências.
+} PoliticaDuplicatas;
+
+/**
+ * @brief Lista de ocorrências usada pela política `DUPLICATAS_LISTA`.
+ * Nesse modo cada ponteiro de folha aponta para uma `ListaCarros` em vez de um `Carro`.
+ */
+typedef struct {
+    int quantidade;
+    int capacidade;
+    Carro **carros;
+} ListaCarros;
+
 typedef struct {
     No *raiz;
     int ordem;
+    PoliticaDuplicatas politica_duplicatas;
+    bool buffer_insercoes; // Se ativo, inserções são acumuladas nos nós internos e descidas em lote.
     long long acessos_de_disco_simulados; //Contador para simular acessos ao disco.
+    Carro **resultado_busca;   // Vetor devolvido por `buscar_todos` quando há inserções pendentes.
+    int capacidade_resultado;
 } BPlusTree;
 
+/**
+ * @brief Estatísticas de forma e ocupação de uma Árvore B+ já construída.
+ */
+typedef struct {
+    int altura;                           // Número de níveis (0 para árvore vazia).
+    long nos_por_nivel[MAX_NIVEIS];       // Quantidade de nós em cada nível, a partir da raiz.
+    long total_nos;
+    long nos_internos;
+    long folhas;
+    long total_chaves_folhas;             // Entradas armazenadas nas folhas.
+    double ocupacao_media_folhas;         // Fração média de chaves usadas por folha (0 a 1).
+    double ocupacao_media_internos;       // Fração média de chaves usadas por nó interno (0 a 1).
+    size_t bytes_totais;                  // Memória realmente alocada para os nós (sizeof(No) cada).
+    size_t bytes_uteis;                   // Memória que os nós ocupariam com arrays do tamanho da ordem.
+    size_t bytes_desperdicados_max_order; // Diferença causada pelos arrays fixos em MAX_ORDER.
+    long slots_livres;                    // Slots de chave não usados dentro do limite da ordem.
+    long mensagens_pendentes;             // Inserções ainda nos buffers dos nós internos.
+} EstatisticasArvore;
+
 /**
  * @brief Aloca memória e inicializa uma nova Árvore B+.
  * @param ordem A ordem da árvore a ser criada.
@@ -34,22 +98,67 @@ BPlusTree* criar_arvore_bplus(int ordem);
  */
 void destruir_arvore(BPlusTree *arvore);
 
+/**
+ * @brief Define a política de chaves duplicadas da árvore.
+ * Só pode ser alterada enquanto a árvore está vazia, pois muda o que as folhas armazenam.
+ * @param arvore A árvore a ser configurada.
+ * @param politica A nova política.
+ * @return `true` se a política foi aplicada, `false` se a árvore já possui chaves.
+ */
+bool definir_politica_duplicatas(BPlusTree *arvore, PoliticaDuplicatas politica);
+
+/**
+ * @brief Ativa ou desativa o modo de inserção com buffers (otimizado para escrita).
+ * Nesse modo cada nó interno acumula até `TAMANHO_BUFFER_INSERCOES` inserções, que são
+ * descidas em lote para os filhos quando o buffer enche; `buscar()` consulta os buffers
+ * no caminho. Só pode ser alterado enquanto a árvore está vazia.
+ * @param arvore A árvore a ser configurada.
+ * @param ativo `true` para usar buffers.
+ * @return `true` se a configuração foi aplicada, `false` se a árvore já possui chaves.
+ */
+bool definir_buffer_insercoes(BPlusTree *arvore, bool ativo);
+
+/**
+ * @brief Desce todas as inserções pendentes nos buffers até as folhas.
+ * Útil antes de percorrer as folhas diretamente ou de medir a forma final da árvore.
+ * @param arvore A árvore a ser modificada.
+ */
+void descarregar_buffers(BPlusTree *arvore);
+
 /**
  * @brief Insere um novo par (chave, valor) na árvore B+.
+ * Se a chave já existir, aplica a política de duplicatas da árvore na mesma descida.
+ * No modo com buffers a política só é aplicada quando a inserção chega à folha.
  * @param arvore A árvore sendo modificada.
  * @param chave O renavam do carro.
  * @param carro Um ponteiro para a estrutura `Carro` a ser inserida.
+ * @return `false` se a chave foi rejeitada (`DUPLICATAS_REJEITAR`, apenas sem buffers), `true` caso contrário.
  */
-void inserir(BPlusTree *arvore, int chave, Carro *carro);
+bool inserir(BPlusTree *arvore, int chave, Carro *carro);
 
 /**
  * @brief Busca por uma chave na árvore.
+ * No modo com buffers, também considera as inserções pendentes no caminho até a folha.
  * @param arvore A Árvore B+ onde a busca será realizada.
  * @param chave A chave (renavam) a ser encontrada.
  * @return Ponteiro para a estrutura `Carro` se encontrada, ou `NULL` caso contrário.
  */
 Carro* buscar(BPlusTree *arvore, int chave);
 
+/**
+ * @brief Busca todos os valores associados a uma chave.
+ * Com `DUPLICATAS_LISTA` devolve a lista de ocorrências; nas demais políticas devolve
+ * o mesmo valor que `buscar` (ou seja, no máximo um). No modo com buffers, as inserções
+ * pendentes da chave entram no resultado (depois das que já estão na folha, da mais antiga
+ * para a mais nova) sem que a árvore seja alterada; nesse caso o vetor pertence à árvore e
+ * vale até a próxima chamada.
+ * @param arvore A Árvore B+ onde a busca será realizada.
+ * @param chave A chave (renavam) a ser encontrada.
+ * @param quantidade Saída: número de valores no vetor retornado (0 se não encontrada).
+ * @return Vetor (somente leitura) com os ponteiros para `Carro`, ou `NULL` se não encontrada.
+ */
+Carro** buscar_todos(BPlusTree *arvore, int chave, int *quantidade);
+
 /**
  * @brief Calcula o tamanho em bytes de um nó da árvore B+ para uma dada ordem.
  * @param arvore Ponteiro para a árvore B+ (pode ser usado para acessar configurações específicas da árvore, se necessário).
@@ -57,4 +166,21 @@ Carro* buscar(BPlusTree *arvore, int chave);
  * @return O tamanho estimado, em bytes, de um único nó da árvore B+.
  */
 size_t tamanho_no_bplustree(BPlusTree* arvore, int ordem);
+
+/**
+ * @brief Percorre a árvore e calcula suas estatísticas de forma e ocupação.
+ * @param arvore A árvore a ser analisada.
+ * @return As estatísticas calculadas (zeradas se a árvore estiver vazia).
+ */
+EstatisticasArvore estatisticas_arvore(BPlusTree *arvore);
+
+/**
+ * @brief Verifica os invariantes estruturais da árvore: chaves ordenadas e dentro dos
+ * limites dos separadores do pai, ponteiros `pai` corretos, folhas no mesmo nível e
+ * encadeamento `prox_folha` completo e em ordem.
+ * A primeira violação encontrada é descrita em `stderr`.
+ * @param arvore A árvore a ser verificada.
+ * @return `true` se todos os invariantes valem, `false` caso contrário.
+ */
+bool verificar_arvore(BPlusTree *arvore);
 #endif
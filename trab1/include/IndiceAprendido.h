@@ -0,0 +1,66 @@
+#ifndef INDICEAPRENDIDO_H
+#define INDICEAPRENDIDO_H
+
+#include <stddef.h>
+#include "BPlusTree.h"
+#include "Carro.h"
+
+#define ERRO_INDICE_APRENDIDO 32 // Erro máximo de posição (em entradas) usado pelo benchmark.
+
+/**
+ * @brief Trecho do modelo linear por partes: prevê a posição de `chave` como
+ * `posicao_inicial + inclinacao * (chave - chave_inicial)`.
+ */
+typedef struct {
+    int chave_inicial;
+    long long posicao_inicial;
+    double inclinacao;
+} SegmentoLinear;
+
+/**
+ * @brief Índice aprendido construído sobre o nível de folhas de uma Árvore B+.
+ * É um retrato da árvore no momento da construção: as entradas das folhas são copiadas
+ * em ordem para vetores contíguos e um modelo linear por partes prevê a posição de cada
+ * chave com erro limitado. Chaves fora do retrato são procuradas na própria árvore.
+ */
+typedef struct {
+    BPlusTree *arvore;           // Árvore de origem, usada como fallback.
+    int erro_maximo;             // Distância máxima entre a posição prevista e a real.
+    long long num_chaves;
+    int *chaves;                 // Chaves das folhas, em ordem.
+    Carro **valores;             // Valor associado a cada chave (o que `buscar()` retornaria).
+    int num_segmentos;
+    SegmentoLinear *segmentos;   // Ordenados por `chave_inicial`.
+} IndiceAprendido;
+
+/**
+ * @brief Percorre o encadeamento de folhas e ajusta os segmentos lineares.
+ * Inserções pendentes em buffers são descarregadas antes.
+ * @param arvore A árvore já carregada.
+ * @param erro_maximo Erro máximo de posição permitido em cada segmento (>= 0).
+ * @return O índice construído, ou `NULL` se a árvore estiver vazia.
+ */
+IndiceAprendido* construir_indice_aprendido(BPlusTree *arvore, int erro_maximo);
+
+/**
+ * @brief Busca uma chave usando o modelo e, se ela não estiver no retrato, a árvore.
+ * @param indice O índice aprendido.
+ * @param chave A chave (renavam) a ser encontrada.
+ * @return Ponteiro para a estrutura `Carro` se encontrada, ou `NULL` caso contrário.
+ */
+Carro* buscar_aprendido(IndiceAprendido *indice, int chave);
+
+/**
+ * @brief Calcula a memória usada pelo índice (vetores de chaves, valores e segmentos).
+ * @param indice O índice aprendido.
+ * @return O tamanho em bytes.
+ */
+size_t memoria_indice_aprendido(IndiceAprendido *indice);
+
+/**
+ * @brief Libera o índice. A árvore de origem não é alterada.
+ * @param indice O índice a ser destruído.
+ */
+void destruir_indice_aprendido(IndiceAprendido *indice);
+
+#endif
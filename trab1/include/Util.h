@@ -6,6 +6,33 @@
 
 #define NUM_BUSCAS_A_REALIZAR 100
 
+// Parâmetros da calibração usada pelo ajuste automático de ordem
+#define MAX_REGISTROS_CALIBRACAO 200000 // Registros inseridos em cada árvore de calibração.
+#define NUM_BUSCAS_CALIBRACAO 20000     // Buscas cronometradas em cada árvore de calibração.
+#define REPETICOES_CALIBRACAO 3         // Cada candidato é medido várias vezes; vale o menor tempo.
+#define MAX_CANDIDATOS_ORDEM 32
+
+/**
+ * @brief Características de memória e disco da máquina, medidas na inicialização.
+ */
+typedef struct {
+    long linha_cache;   // Tamanho da linha de cache L1 de dados, em bytes.
+    long cache_l1;      // Tamanho da cache L1 de dados, em bytes.
+    long cache_l2;      // Tamanho da cache L2, em bytes.
+    long bloco_disco;   // Tamanho do bloco do sistema de arquivos, em bytes.
+} InfoHardware;
+
+/**
+ * @brief Resultado do ajuste automático de ordem.
+ */
+typedef struct {
+    int ordem_memoria;           // Ordem com menor tempo medido de inserção + busca.
+    int ordem_disco;             // Ordem com menor custo simulado de acesso a disco.
+    double tempo_memoria_ms;     // Tempo medido para `ordem_memoria`.
+    double custo_disco;          // Custo simulado (acessos × blocos por nó) para `ordem_disco`.
+    char justificativa[512];     // Explicação legível da escolha.
+} AjusteOrdem;
+
 extern int chaves_para_busca[NUM_BUSCAS_A_REALIZAR];
 /**
  * @brief Conta o número de linhas (registros) em um arquivo.
@@ -36,4 +63,24 @@ void preparar_chaves_busca(const Carro *todos_os_carros, int num_registros);
  */
 long get_block_size(const char *path);
 
+/**
+ * @brief Mede tamanho da linha de cache, das caches L1/L2 e do bloco de disco.
+ * Valores que o sistema não informar recebem estimativas conservadoras (64 B, 32 KB, 256 KB).
+ * @param path Caminho usado para consultar o tamanho do bloco de disco.
+ * @return As características medidas.
+ */
+InfoHardware medir_hardware(const char *path);
+
+/**
+ * @brief Escolhe as ordens da árvore para uso em memória e em disco.
+ * Gera ordens candidatas a partir do hardware (nós que ocupam múltiplos da linha de cache,
+ * cabem na L1 ou em um bloco de disco), cronometra inserção + busca de cada candidata em uma
+ * amostra dos registros e escolhe a mais rápida para memória e a de menor custo simulado para disco.
+ * @param carros Registros usados na calibração.
+ * @param num_registros Quantidade de registros disponíveis.
+ * @param hw Características da máquina, obtidas com `medir_hardware()`.
+ * @return As ordens escolhidas e a justificativa.
+ */
+AjusteOrdem ajustar_ordem_automaticamente(const Carro *carros, int num_registros, const InfoHardware *hw);
+
 #endif
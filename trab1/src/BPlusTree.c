@@ -1,6 +1,8 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <stdbool.h>
+#include <limits.h>
+#include <string.h>
 #include "../include/BPlusTree.h"
 
 
@@ -30,8 +32,117 @@ static void inserir_no_pai(BPlusTree *arvore, No *no_esquerdo, int chave, No *no
 /**
  * @brief Libera recursivamente os nós da árvore.
  * @param no O nó raiz da árvore (ou sub-árvore) a ser destruída.
+ * @param folhas_com_lista Se `true`, também libera as `ListaCarros` apontadas pelas folhas.
  */
-static void destruir_nos_recursivo(No *no);
+static void destruir_nos_recursivo(No *no, bool folhas_com_lista);
+
+/**
+ * @brief Desce da raiz até a folha e procura a chave nela, contando os acessos simulados.
+ * @param arvore A árvore onde a busca será realizada.
+ * @param chave A chave procurada.
+ * @param indice Saída: posição da chave na folha, ou -1 se não encontrada.
+ * @param pendente Saída opcional: valor encontrado nos buffers do caminho (o mais novo com
+ * `DUPLICATAS_SUBSTITUIR`, o mais antigo nas demais políticas), ou `NULL`.
+ * @return A folha onde a chave está (ou deveria estar), ou `NULL` se a árvore está vazia.
+ */
+static No* buscar_folha(BPlusTree *arvore, int chave, int *indice, Carro **pendente);
+
+/**
+ * @brief Desce da raiz até a folha onde a chave deve ser inserida, sem contar acessos.
+ * @param arvore A árvore (não vazia).
+ * @param chave A chave a ser inserida.
+ * @return A folha de destino.
+ */
+static No* descer_ate_folha(BPlusTree *arvore, int chave);
+
+/**
+ * @brief Insere o par em uma folha já localizada, aplicando a política de duplicatas
+ * e dividindo a folha se ela estourar.
+ * @param arvore A árvore sendo modificada.
+ * @param folha A folha de destino.
+ * @param chave A chave a ser inserida.
+ * @param carro O registro a ser inserido.
+ * @return `false` se a chave foi rejeitada, `true` caso contrário.
+ */
+static bool inserir_na_folha(BPlusTree *arvore, No *folha, int chave, Carro *carro);
+
+/**
+ * @brief Aloca o buffer de inserções de um nó interno, se o modo com buffers estiver ativo.
+ * @param arvore A árvore à qual o nó pertence.
+ * @param no O nó interno recém-criado.
+ */
+static void preparar_buffer(BPlusTree *arvore, No *no);
+
+/**
+ * @brief Acrescenta uma inserção pendente ao fim de um buffer, expandindo-o se necessário.
+ * @param buffer O buffer a ser modificado.
+ * @param chave A chave da inserção.
+ * @param carro O registro da inserção.
+ */
+static void buffer_adicionar(BufferInsercoes *buffer, int chave, Carro *carro);
+
+/**
+ * @brief Desce as mensagens do buffer de um nó interno para seus filhos.
+ * Filhos folha recebem as inserções diretamente; filhos internos as acumulam em seus
+ * próprios buffers, que são descarregados em cascata se encherem.
+ * @param arvore A árvore sendo modificada.
+ * @param no O nó interno cujo buffer será esvaziado.
+ */
+static void descarregar_no(BPlusTree *arvore, No *no);
+
+/**
+ * @brief Recolhe (e esvazia) os buffers de uma sub-árvore em pós-ordem, de modo que
+ * mensagens de uma mesma chave fiquem da mais antiga para a mais nova.
+ * @param no O nó raiz da sub-árvore.
+ * @param destino Buffer que recebe as mensagens.
+ */
+static void recolher_buffers(No *no, BufferInsercoes *destino);
+
+/**
+ * @brief Garante espaço para `n` ponteiros no vetor de resultado de `buscar_todos`.
+ * @param arvore A árvore dona do vetor.
+ * @param n Quantidade mínima de posições.
+ */
+static void reservar_resultado(BPlusTree *arvore, int n);
+
+/**
+ * @brief Cria o valor que será guardado na folha, de acordo com a política de duplicatas.
+ * @param arvore A árvore sendo modificada.
+ * @param carro O registro a ser armazenado.
+ * @return O próprio `carro`, ou uma nova `ListaCarros` contendo-o (`DUPLICATAS_LISTA`).
+ */
+static void* criar_valor_folha(BPlusTree *arvore, Carro *carro);
+
+/**
+ * @brief Acrescenta um registro ao fim de uma lista de ocorrências.
+ * @param lista A lista a ser modificada.
+ * @param carro O registro a ser acrescentado.
+ */
+static void lista_carros_adicionar(ListaCarros *lista, Carro *carro);
+
+/**
+ * @brief Acumula recursivamente as estatísticas de uma sub-árvore.
+ * @param arvore A árvore analisada (usada para a ordem).
+ * @param no O nó raiz da sub-árvore.
+ * @param nivel O nível do nó (0 para a raiz).
+ * @param est As estatísticas sendo acumuladas.
+ */
+static void coletar_estatisticas(BPlusTree *arvore, No *no, int nivel, EstatisticasArvore *est);
+
+/**
+ * @brief Verifica recursivamente os invariantes de uma sub-árvore.
+ * @param arvore A árvore verificada.
+ * @param no O nó raiz da sub-árvore.
+ * @param minimo Menor chave permitida (inclusive).
+ * @param maximo Maior chave permitida.
+ * @param maximo_inclusivo Se a chave `maximo` é permitida (só com duplicatas).
+ * @param nivel O nível do nó (0 para a raiz).
+ * @param nivel_folhas Nível das folhas; -1 até a primeira folha ser encontrada.
+ * @param ultima_folha A última folha visitada, para conferir o encadeamento.
+ * @return `true` se a sub-árvore é válida.
+ */
+static bool verificar_no(BPlusTree *arvore, No *no, long long minimo, long long maximo, bool maximo_inclusivo,
+                         int nivel, int *nivel_folhas, No **ultima_folha);
 
 
 //----------------------------------Funções definidas no .h----------------------------------
@@ -47,7 +158,11 @@ BPlusTree* criar_arvore_bplus(int ordem) {
     }
     arvore->raiz = NULL;
     arvore->ordem = ordem;
+    arvore->politica_duplicatas = DUPLICATAS_PERMITIR;
+    arvore->buffer_insercoes = false;
     arvore->acessos_de_disco_simulados = 0; // Inicializa o novo contador
+    arvore->resultado_busca = NULL;
+    arvore->capacidade_resultado = 0;
     return arvore;
 }
 
@@ -55,79 +170,142 @@ BPlusTree* criar_arvore_bplus(int ordem) {
 
 void destruir_arvore(BPlusTree *arvore) {
     if (arvore == NULL) return;
-    destruir_nos_recursivo(arvore->raiz);
+    destruir_nos_recursivo(arvore->raiz, arvore->politica_duplicatas == DUPLICATAS_LISTA);
+    free(arvore->resultado_busca);
     free(arvore);
 }
 
 
-void inserir(BPlusTree *arvore, int chave, Carro *carro) {
+bool definir_politica_duplicatas(BPlusTree *arvore, PoliticaDuplicatas politica) {
+    if (arvore == NULL || arvore->raiz != NULL) return false;
+    arvore->politica_duplicatas = politica;
+    return true;
+}
+
+
+bool definir_buffer_insercoes(BPlusTree *arvore, bool ativo) {
+    if (arvore == NULL || arvore->raiz != NULL) return false;
+    arvore->buffer_insercoes = ativo;
+    return true;
+}
+
+
+void descarregar_buffers(BPlusTree *arvore) {
+    if (arvore == NULL || arvore->raiz == NULL || !arvore->buffer_insercoes) return;
+
+    BufferInsercoes pendentes = {0, 0, NULL};
+    recolher_buffers(arvore->raiz, &pendentes);
+
+    // Com os buffers vazios, cada mensagem vira uma inserção comum na folha. A ordem de
+    // recolhimento já deixa as mensagens de uma mesma chave da mais antiga para a mais nova.
+    for (int i = 0; i < pendentes.quantidade; i++) {
+        MensagemInsercao *m = &pendentes.mensagens[i];
+        inserir_na_folha(arvore, descer_ate_folha(arvore, m->chave), m->chave, m->carro);
+    }
+    free(pendentes.mensagens);
+}
+
+
+bool inserir(BPlusTree *arvore, int chave, Carro *carro) {
     // Caso 1: A árvore está vazia.
     if (arvore->raiz == NULL) {
         arvore->raiz = criar_no();
         arvore->raiz->folha = true;
         arvore->raiz->chaves[0] = chave;
-        arvore->raiz->ponteiros[0] = carro;
+        arvore->raiz->ponteiros[0] = criar_valor_folha(arvore, carro);
         arvore->raiz->num_chaves = 1;
-        return;
+        return true;
     }
 
-    // Caso 2: Encontra o nó folha correto para a inserção.
-    No *no_atual = arvore->raiz;
-    while (!no_atual->folha) {
-        int i = 0;
-        while (i < no_atual->num_chaves && chave >= no_atual->chaves[i]) {
-            i++;
+    // Caso 2: No modo com buffers, a inserção fica pendente na raiz e desce em lote depois.
+    if (arvore->buffer_insercoes && !arvore->raiz->folha) {
+        buffer_adicionar(arvore->raiz->buffer, chave, carro);
+        if (arvore->raiz->buffer->quantidade >= TAMANHO_BUFFER_INSERCOES) {
+            descarregar_no(arvore, arvore->raiz);
         }
-        no_atual = (No*)no_atual->ponteiros[i];
+        return true;
     }
 
-    // Agora `no_atual` é o nó folha onde a chave deve ser inserida.
-    
-    // Desloca as chaves e ponteiros existentes para abrir espaço para o novo par.
-    int i = no_atual->num_chaves;
-    while (i > 0 && no_atual->chaves[i - 1] > chave) {
-        no_atual->chaves[i] = no_atual->chaves[i - 1];
-        no_atual->ponteiros[i] = no_atual->ponteiros[i - 1];
-        i--;
-    }
-    
-    // Insere a nova chave e o ponteiro na posição correta.
-    no_atual->chaves[i] = chave;
-    no_atual->ponteiros[i] = carro;
-    no_atual->num_chaves++;
-
-    // Caso 3: Se o nó ficou superlotado, divide-o.
-    // A ordem define o número MÁXIMO de ponteiros. O número máximo de chaves é ordem-1.
-    // Se num_chaves == ordem, significa que estourou o limite.
-    if (no_atual->num_chaves == arvore->ordem) {
-        dividir_no(arvore, no_atual);
-    }
+    // Caso 3: Encontra o nó folha correto e insere nele.
+    return inserir_na_folha(arvore, descer_ate_folha(arvore, chave), chave, carro);
 }
 
 
 
 Carro* buscar(BPlusTree *arvore, int chave) {
-    if (arvore == NULL || arvore->raiz == NULL) return NULL;
+    int indice;
+    Carro *pendente = NULL;
+    No *folha = buscar_folha(arvore, chave, &indice, &pendente);
+    if (folha == NULL) return NULL;
+
+    // Uma inserção pendente só prevalece sobre a folha quando substitui valores antigos.
+    if (pendente != NULL && (indice < 0 || arvore->politica_duplicatas == DUPLICATAS_SUBSTITUIR)) {
+        return pendente;
+    }
+    if (indice < 0) return NULL;
 
-    No *no_atual = arvore->raiz;
-    arvore->acessos_de_disco_simulados++; // Incrementa para o acesso à raiz
+    if (arvore->politica_duplicatas == DUPLICATAS_LISTA) {
+        return ((ListaCarros*)folha->ponteiros[indice])->carros[0];
+    }
+    return (Carro*)folha->ponteiros[indice];
+}
 
-    while (!no_atual->folha) {
-        int i = 0;
-        while (i < no_atual->num_chaves && chave >= no_atual->chaves[i]) {
-            i++;
+
+Carro** buscar_todos(BPlusTree *arvore, int chave, int *quantidade) {
+    int indice;
+    Carro *pendente = NULL;
+    *quantidade = 0;
+    No *folha = buscar_folha(arvore, chave, &indice, &pendente);
+    if (folha == NULL) return NULL;
+
+    // Sem inserções pendentes para a chave, o vetor é o da própria folha.
+    if (pendente == NULL || (indice >= 0 && arvore->politica_duplicatas != DUPLICATAS_LISTA &&
+                             arvore->politica_duplicatas != DUPLICATAS_SUBSTITUIR)) {
+        if (indice < 0) return NULL;
+        if (arvore->politica_duplicatas == DUPLICATAS_LISTA) {
+            ListaCarros *lista = (ListaCarros*)folha->ponteiros[indice];
+            *quantidade = lista->quantidade;
+            return lista->carros;
         }
-        no_atual = (No*)no_atual->ponteiros[i];
-        arvore->acessos_de_disco_simulados++; // Incrementa para cada nó visitado no caminho
+        *quantidade = 1;
+        return (Carro**)&folha->ponteiros[indice];
     }
 
-    // Busca linear na folha
-    for (int i = 0; i < no_atual->num_chaves; i++) {
-        if (no_atual->chaves[i] == chave) {
-            return (Carro*)no_atual->ponteiros[i];
+    // Nas outras políticas vale o valor pendente, como em `buscar`.
+    if (arvore->politica_duplicatas != DUPLICATAS_LISTA) {
+        reservar_resultado(arvore, 1);
+        arvore->resultado_busca[0] = pendente;
+        *quantidade = 1;
+        return arvore->resultado_busca;
+    }
+
+    // Com DUPLICATAS_LISTA, junta a lista da folha e as mensagens dos buffers do caminho,
+    // do mais fundo (mais antigo) para a raiz, como ficariam depois de descarregar.
+    No *caminho[MAX_NIVEIS];
+    int niveis = 0;
+    for (No *no = arvore->raiz; !no->folha; ) {
+        caminho[niveis++] = no;
+        int i = 0;
+        while (i < no->num_chaves && chave >= no->chaves[i]) i++;
+        no = (No*)no->ponteiros[i];
+    }
+    int n = 0;
+    if (indice >= 0) {
+        ListaCarros *lista = (ListaCarros*)folha->ponteiros[indice];
+        reservar_resultado(arvore, lista->quantidade);
+        memcpy(arvore->resultado_busca, lista->carros, lista->quantidade * sizeof(Carro*));
+        n = lista->quantidade;
+    }
+    for (int nivel = niveis - 1; nivel >= 0; nivel--) {
+        BufferInsercoes *buffer = caminho[nivel]->buffer;
+        for (int i = 0; buffer != NULL && i < buffer->quantidade; i++) {
+            if (buffer->mensagens[i].chave != chave) continue;
+            reservar_resultado(arvore, n + 1);
+            arvore->resultado_busca[n++] = buffer->mensagens[i].carro;
         }
     }
-    return NULL;
+    *quantidade = n;
+    return arvore->resultado_busca;
 }
 
 
@@ -137,6 +315,10 @@ size_t tamanho_no_bplustree(BPlusTree* arvore, int ordem) {
     //                      'folha'      'num_chaves'        'prox_folha'            'pai'
     size_t tamanho_base = sizeof(bool) + sizeof(int)   +     sizeof(struct No*) +    sizeof(struct No*);
 
+    //O ponteiro para o buffer só conta quando o modo com buffers está ativo, para não
+    //mudar o tamanho (e a ordem escolhida pelo ajuste automático) de quem não o usa.
+    if (arvore != NULL && arvore->buffer_insercoes) tamanho_base += sizeof(BufferInsercoes*);
+
     //Calcula o tamanho da parte útil do array de chaves.
     size_t tamanho_chaves_uteis = sizeof(int) * (ordem - 1);
 
@@ -147,6 +329,42 @@ size_t tamanho_no_bplustree(BPlusTree* arvore, int ordem) {
     return tamanho_base + tamanho_chaves_uteis + tamanho_ponteiros_uteis;
 }
 
+EstatisticasArvore estatisticas_arvore(BPlusTree *arvore) {
+    EstatisticasArvore est = {0};
+    if (arvore == NULL || arvore->raiz == NULL) return est;
+
+    coletar_estatisticas(arvore, arvore->raiz, 0, &est);
+
+    // Os acumuladores de ocupação guardam a soma das frações; aqui viram médias.
+    if (est.folhas > 0) est.ocupacao_media_folhas /= est.folhas;
+    if (est.nos_internos > 0) est.ocupacao_media_internos /= est.nos_internos;
+
+    est.bytes_totais = est.total_nos * sizeof(No);
+    est.bytes_uteis = est.total_nos * tamanho_no_bplustree(arvore, arvore->ordem);
+    est.bytes_desperdicados_max_order = est.bytes_totais - est.bytes_uteis;
+    return est;
+}
+
+
+bool verificar_arvore(BPlusTree *arvore) {
+    if (arvore == NULL || arvore->raiz == NULL) return true;
+    if (arvore->raiz->pai != NULL) {
+        fprintf(stderr, "Invariante violado: a raiz possui pai.\n");
+        return false;
+    }
+
+    int nivel_folhas = -1;
+    No *ultima_folha = NULL;
+    if (!verificar_no(arvore, arvore->raiz, LLONG_MIN, LLONG_MAX, true, 0, &nivel_folhas, &ultima_folha)) {
+        return false;
+    }
+    if (ultima_folha->prox_folha != NULL) {
+        fprintf(stderr, "Invariante violado: a última folha aponta para outra folha.\n");
+        return false;
+    }
+    return true;
+}
+
 //----------------------------------Funções internas (implementações)----------------------------------
 No* criar_no() {
     No *novo_no = (No*)calloc(1, sizeof(No));
@@ -168,6 +386,18 @@ void dividir_no(BPlusTree *arvore, No *no) {
     if (!no->folha) { // Divisão de nó interno
         chave_promovida = no->chaves[meio_idx];
 
+        // Mensagens pendentes com chave >= promovida passam a pertencer ao irmão.
+        preparar_buffer(arvore, irmao_direito);
+        if (no->buffer) {
+            int mantidas = 0;
+            for (int i = 0; i < no->buffer->quantidade; i++) {
+                MensagemInsercao m = no->buffer->mensagens[i];
+                if (m.chave >= chave_promovida) buffer_adicionar(irmao_direito->buffer, m.chave, m.carro);
+                else no->buffer->mensagens[mantidas++] = m;
+            }
+            no->buffer->quantidade = mantidas;
+        }
+
         // Copia a segunda metade das chaves e ponteiros para o irmão
         for (int i = meio_idx + 1; i < arvore->ordem; i++) {
             irmao_direito->chaves[i - (meio_idx + 1)] = no->chaves[i];
@@ -213,6 +443,7 @@ void inserir_no_pai(BPlusTree *arvore, No *no_esquerdo, int chave, No *no_direit
         nova_raiz->ponteiros[0] = no_esquerdo;
         nova_raiz->ponteiros[1] = no_direito;
         nova_raiz->num_chaves = 1;
+        preparar_buffer(arvore, nova_raiz);
         
         arvore->raiz = nova_raiz;
         no_esquerdo->pai = nova_raiz;
@@ -250,12 +481,364 @@ void inserir_no_pai(BPlusTree *arvore, No *no_esquerdo, int chave, No *no_direit
 }
 
 
-void destruir_nos_recursivo(No *no) {
+No* buscar_folha(BPlusTree *arvore, int chave, int *indice, Carro **pendente) {
+    *indice = -1;
+    if (arvore == NULL || arvore->raiz == NULL) return NULL;
+
+    No *no_atual = arvore->raiz;
+    arvore->acessos_de_disco_simulados++; // Incrementa para o acesso à raiz
+
+    // Buffers mais próximos da raiz guardam mensagens mais novas; dentro de um buffer, as
+    // mais novas ficam no fim.
+    bool quer_mais_nova = arvore->politica_duplicatas == DUPLICATAS_SUBSTITUIR;
+    while (!no_atual->folha) {
+        if (pendente != NULL && no_atual->buffer != NULL && !(quer_mais_nova && *pendente != NULL)) {
+            for (int i = 0; i < no_atual->buffer->quantidade; i++) {
+                if (no_atual->buffer->mensagens[i].chave == chave) {
+                    *pendente = no_atual->buffer->mensagens[i].carro;
+                    if (!quer_mais_nova) break;
+                }
+            }
+        }
+
+        int i = 0;
+        while (i < no_atual->num_chaves && chave >= no_atual->chaves[i]) {
+            i++;
+        }
+        no_atual = (No*)no_atual->ponteiros[i];
+        arvore->acessos_de_disco_simulados++; // Incrementa para cada nó visitado no caminho
+    }
+
+    // Busca linear na folha
+    for (int i = 0; i < no_atual->num_chaves; i++) {
+        if (no_atual->chaves[i] == chave) {
+            *indice = i;
+            break;
+        }
+    }
+    return no_atual;
+}
+
+
+No* descer_ate_folha(BPlusTree *arvore, int chave) {
+    No *no_atual = arvore->raiz;
+    while (!no_atual->folha) {
+        int i = 0;
+        while (i < no_atual->num_chaves && chave >= no_atual->chaves[i]) {
+            i++;
+        }
+        no_atual = (No*)no_atual->ponteiros[i];
+    }
+    return no_atual;
+}
+
+
+bool inserir_na_folha(BPlusTree *arvore, No *folha, int chave, Carro *carro) {
+    // Posição logo após a última chave <= `chave`.
+    int pos = 0;
+    while (pos < folha->num_chaves && folha->chaves[pos] <= chave) {
+        pos++;
+    }
+
+    // Como a descida segue para a direita em chaves iguais, uma chave já existente
+    // só pode estar nesta folha, imediatamente antes de `pos`.
+    if (arvore->politica_duplicatas != DUPLICATAS_PERMITIR && pos > 0 && folha->chaves[pos - 1] == chave) {
+        switch (arvore->politica_duplicatas) {
+            case DUPLICATAS_REJEITAR:
+                return false;
+            case DUPLICATAS_SUBSTITUIR:
+                folha->ponteiros[pos - 1] = carro;
+                return true;
+            case DUPLICATAS_LISTA:
+                lista_carros_adicionar((ListaCarros*)folha->ponteiros[pos - 1], carro);
+                return true;
+            default:
+                break;
+        }
+    }
+
+    // Desloca as chaves e ponteiros existentes para abrir espaço para o novo par.
+    for (int i = folha->num_chaves; i > pos; i--) {
+        folha->chaves[i] = folha->chaves[i - 1];
+        folha->ponteiros[i] = folha->ponteiros[i - 1];
+    }
+
+    // Insere a nova chave e o ponteiro na posição correta.
+    folha->chaves[pos] = chave;
+    folha->ponteiros[pos] = criar_valor_folha(arvore, carro);
+    folha->num_chaves++;
+
+    // Se o nó ficou superlotado, divide-o.
+    // A ordem define o número MÁXIMO de ponteiros. O número máximo de chaves é ordem-1.
+    // Se num_chaves == ordem, significa que estourou o limite.
+    if (folha->num_chaves == arvore->ordem) {
+        dividir_no(arvore, folha);
+    }
+    return true;
+}
+
+
+void preparar_buffer(BPlusTree *arvore, No *no) {
+    if (!arvore->buffer_insercoes || no->buffer != NULL) return;
+    no->buffer = (BufferInsercoes*)calloc(1, sizeof(BufferInsercoes));
+    if (!no->buffer) {
+        perror("Falha ao alocar memória para o buffer de inserções");
+        exit(EXIT_FAILURE);
+    }
+}
+
+
+void buffer_adicionar(BufferInsercoes *buffer, int chave, Carro *carro) {
+    if (buffer->quantidade == buffer->capacidade) {
+        int nova_capacidade = buffer->capacidade ? buffer->capacidade * 2 : TAMANHO_BUFFER_INSERCOES;
+        MensagemInsercao *novas = (MensagemInsercao*)realloc(buffer->mensagens, nova_capacidade * sizeof(MensagemInsercao));
+        if (!novas) {
+            perror("Falha ao expandir o buffer de inserções");
+            exit(EXIT_FAILURE);
+        }
+        buffer->mensagens = novas;
+        buffer->capacidade = nova_capacidade;
+    }
+    buffer->mensagens[buffer->quantidade].chave = chave;
+    buffer->mensagens[buffer->quantidade].carro = carro;
+    buffer->quantidade++;
+}
+
+
+void descarregar_no(BPlusTree *arvore, No *no) {
+    int qtd = no->buffer->quantidade;
+    if (qtd == 0) return;
+
+    // Tira as mensagens do nó antes de descê-las: as divisões causadas pela descarga
+    // podem dividir este nó e, com ele, o buffer.
+    MensagemInsercao *mensagens = (MensagemInsercao*)malloc(qtd * sizeof(MensagemInsercao));
+    No **destinos = (No**)malloc(qtd * sizeof(No*));
+    if (!mensagens || !destinos) {
+        perror("Falha ao alocar memória para descarregar o buffer");
+        exit(EXIT_FAILURE);
+    }
+    memcpy(mensagens, no->buffer->mensagens, qtd * sizeof(MensagemInsercao));
+    no->buffer->quantidade = 0;
+
+    // Ordenação estável por chave (inserção direta, o buffer é pequeno), preservando a
+    // ordem de chegada entre mensagens da mesma chave.
+    for (int i = 1; i < qtd; i++) {
+        MensagemInsercao m = mensagens[i];
+        int j = i - 1;
+        while (j >= 0 && mensagens[j].chave > m.chave) {
+            mensagens[j + 1] = mensagens[j];
+            j--;
+        }
+        mensagens[j + 1] = m;
+    }
+
+    // Resolve o filho de cada mensagem antes de alterar a árvore; daqui em diante os
+    // filhos são referenciados por ponteiro, que continua válido mesmo após divisões.
+    int i = 0;
+    for (int k = 0; k < qtd; k++) {
+        while (i < no->num_chaves && mensagens[k].chave >= no->chaves[i]) {
+            i++;
+        }
+        destinos[k] = (No*)no->ponteiros[i];
+    }
+
+    for (int inicio = 0; inicio < qtd; ) {
+        No *filho = destinos[inicio];
+        int fim = inicio;
+        while (fim < qtd && destinos[fim] == filho) {
+            fim++;
+        }
+
+        if (filho->folha) {
+            // Em ordem crescente, seguindo o encadeamento caso a folha se divida no caminho.
+            // As folhas criadas assim começam com chaves do próprio intervalo do filho.
+            No *folha = filho;
+            for (int k = inicio; k < fim; k++) {
+                while (folha->prox_folha != NULL && folha->prox_folha->chaves[0] <= mensagens[k].chave) {
+                    folha = folha->prox_folha;
+                }
+                inserir_na_folha(arvore, folha, mensagens[k].chave, mensagens[k].carro);
+            }
+        } else {
+            for (int k = inicio; k < fim; k++) {
+                buffer_adicionar(filho->buffer, mensagens[k].chave, mensagens[k].carro);
+            }
+            if (filho->buffer->quantidade >= TAMANHO_BUFFER_INSERCOES) {
+                descarregar_no(arvore, filho);
+            }
+        }
+        inicio = fim;
+    }
+
+    free(destinos);
+    free(mensagens);
+}
+
+
+void recolher_buffers(No *no, BufferInsercoes *destino) {
+    if (no == NULL || no->folha) return;
+    for (int i = 0; i <= no->num_chaves; i++) {
+        recolher_buffers((No*)no->ponteiros[i], destino);
+    }
+    if (no->buffer == NULL) return;
+    for (int i = 0; i < no->buffer->quantidade; i++) {
+        buffer_adicionar(destino, no->buffer->mensagens[i].chave, no->buffer->mensagens[i].carro);
+    }
+    no->buffer->quantidade = 0;
+}
+
+
+void reservar_resultado(BPlusTree *arvore, int n) {
+    if (n <= arvore->capacidade_resultado) return;
+    int nova_capacidade = arvore->capacidade_resultado ? arvore->capacidade_resultado : 8;
+    while (nova_capacidade < n) nova_capacidade *= 2;
+    Carro **novo = (Carro**)realloc(arvore->resultado_busca, nova_capacidade * sizeof(Carro*));
+    if (!novo) {
+        perror("Falha ao alocar memória para o resultado da busca");
+        exit(EXIT_FAILURE);
+    }
+    arvore->resultado_busca = novo;
+    arvore->capacidade_resultado = nova_capacidade;
+}
+
+
+void* criar_valor_folha(BPlusTree *arvore, Carro *carro) {
+    if (arvore->politica_duplicatas != DUPLICATAS_LISTA) return carro;
+
+    ListaCarros *lista = (ListaCarros*)malloc(sizeof(ListaCarros));
+    if (!lista) {
+        perror("Falha ao alocar memória para a lista de ocorrências");
+        exit(EXIT_FAILURE);
+    }
+    lista->quantidade = 0;
+    lista->capacidade = 0;
+    lista->carros = NULL;
+    lista_carros_adicionar(lista, carro);
+    return lista;
+}
+
+
+void lista_carros_adicionar(ListaCarros *lista, Carro *carro) {
+    if (lista->quantidade == lista->capacidade) {
+        int nova_capacidade = lista->capacidade ? lista->capacidade * 2 : 2;
+        Carro **novos = (Carro**)realloc(lista->carros, nova_capacidade * sizeof(Carro*));
+        if (!novos) {
+            perror("Falha ao expandir a lista de ocorrências");
+            exit(EXIT_FAILURE);
+        }
+        lista->carros = novos;
+        lista->capacidade = nova_capacidade;
+    }
+    lista->carros[lista->quantidade++] = carro;
+}
+
+
+void destruir_nos_recursivo(No *no, bool folhas_com_lista) {
     if (no == NULL) return;
     if (!no->folha) {
         for (int i = 0; i <= no->num_chaves; i++) {
-            destruir_nos_recursivo(no->ponteiros[i]);
+            destruir_nos_recursivo(no->ponteiros[i], folhas_com_lista);
+        }
+        if (no->buffer) {
+            free(no->buffer->mensagens);
+            free(no->buffer);
+        }
+    } else if (folhas_com_lista) {
+        for (int i = 0; i < no->num_chaves; i++) {
+            ListaCarros *lista = (ListaCarros*)no->ponteiros[i];
+            free(lista->carros);
+            free(lista);
         }
     }
     free(no);
+}
+
+
+void coletar_estatisticas(BPlusTree *arvore, No *no, int nivel, EstatisticasArvore *est) {
+    if (nivel + 1 > est->altura) est->altura = nivel + 1;
+    if (nivel < MAX_NIVEIS) est->nos_por_nivel[nivel]++;
+    est->total_nos++;
+    // Folhas e nós internos comportam no máximo ordem-1 chaves.
+    est->slots_livres += (arvore->ordem - 1) - no->num_chaves;
+
+    if (no->folha) {
+        est->folhas++;
+        est->total_chaves_folhas += no->num_chaves;
+        est->ocupacao_media_folhas += (double)no->num_chaves / (arvore->ordem - 1);
+        return;
+    }
+
+    est->nos_internos++;
+    if (no->buffer) est->mensagens_pendentes += no->buffer->quantidade;
+    est->ocupacao_media_internos += (double)no->num_chaves / (arvore->ordem - 1);
+    for (int i = 0; i <= no->num_chaves; i++) {
+        coletar_estatisticas(arvore, (No*)no->ponteiros[i], nivel + 1, est);
+    }
+}
+
+
+bool verificar_no(BPlusTree *arvore, No *no, long long minimo, long long maximo, bool maximo_inclusivo,
+                  int nivel, int *nivel_folhas, No **ultima_folha) {
+    if (no == NULL) {
+        fprintf(stderr, "Invariante violado: ponteiro de filho nulo no nível %d.\n", nivel);
+        return false;
+    }
+    if (no->num_chaves < 1 || no->num_chaves > arvore->ordem - 1) {
+        fprintf(stderr, "Invariante violado: nó no nível %d com %d chaves (ordem %d).\n",
+                nivel, no->num_chaves, arvore->ordem);
+        return false;
+    }
+
+    // Chaves ordenadas (estritamente, quando a política impede duplicatas) e dentro dos limites.
+    bool permite_iguais = arvore->politica_duplicatas == DUPLICATAS_PERMITIR;
+    for (int i = 0; i < no->num_chaves; i++) {
+        long long chave = no->chaves[i];
+        if (chave < minimo || chave > maximo || (chave == maximo && !maximo_inclusivo)) {
+            fprintf(stderr, "Invariante violado: chave %lld fora do intervalo do pai no nível %d.\n", chave, nivel);
+            return false;
+        }
+        if (i > 0 && (no->chaves[i - 1] > chave || (!permite_iguais && no->chaves[i - 1] == chave))) {
+            fprintf(stderr, "Invariante violado: chaves fora de ordem no nível %d.\n", nivel);
+            return false;
+        }
+    }
+
+    if (no->folha) {
+        if (*nivel_folhas == -1) *nivel_folhas = nivel;
+        if (*nivel_folhas != nivel) {
+            fprintf(stderr, "Invariante violado: folhas nos níveis %d e %d.\n", *nivel_folhas, nivel);
+            return false;
+        }
+        // A folha anterior na ordem da árvore deve apontar exatamente para esta.
+        if (*ultima_folha != NULL && (*ultima_folha)->prox_folha != no) {
+            fprintf(stderr, "Invariante violado: encadeamento de folhas quebrado no nível %d.\n", nivel);
+            return false;
+        }
+        *ultima_folha = no;
+        return true;
+    }
+
+    // Inserções pendentes também precisam estar no intervalo do nó.
+    for (int i = 0; no->buffer != NULL && i < no->buffer->quantidade; i++) {
+        long long chave = no->buffer->mensagens[i].chave;
+        if (chave < minimo || chave > maximo || (chave == maximo && !maximo_inclusivo)) {
+            fprintf(stderr, "Invariante violado: mensagem pendente %lld fora do intervalo no nível %d.\n", chave, nivel);
+            return false;
+        }
+    }
+
+    for (int i = 0; i <= no->num_chaves; i++) {
+        No *filho = (No*)no->ponteiros[i];
+        if (filho != NULL && filho->pai != no) {
+            fprintf(stderr, "Invariante violado: ponteiro `pai` incorreto no nível %d.\n", nivel + 1);
+            return false;
+        }
+        long long filho_min = (i == 0) ? minimo : no->chaves[i - 1];
+        long long filho_max = (i == no->num_chaves) ? maximo : no->chaves[i];
+        bool filho_max_inclusivo = (i == no->num_chaves) ? maximo_inclusivo : permite_iguais;
+        if (!verificar_no(arvore, filho, filho_min, filho_max, filho_max_inclusivo, nivel + 1, nivel_folhas, ultima_folha)) {
+            return false;
+        }
+    }
+    return true;
 }
\ No newline at end of file
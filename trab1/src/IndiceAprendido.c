@@ -0,0 +1,180 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include "../include/IndiceAprendido.h"
+
+
+//---------------------------------- Protótipos funções internas----------------------------------
+/**
+ * @brief Copia as entradas das folhas, em ordem, para os vetores do índice.
+ * @param indice O índice sendo construído (com `arvore` preenchida).
+ */
+static void copiar_folhas(IndiceAprendido *indice);
+
+/**
+ * @brief Ajusta os segmentos com o algoritmo guloso do cone: cada segmento cresce enquanto
+ * existir uma inclinação que mantenha todas as suas chaves dentro do erro máximo.
+ * Só a primeira ocorrência de cada chave entra no modelo.
+ * @param indice O índice com os vetores de chaves preenchidos.
+ */
+static void ajustar_segmentos(IndiceAprendido *indice);
+
+/**
+ * @brief Acrescenta um segmento ao índice, expandindo o vetor se necessário.
+ */
+static void adicionar_segmento(IndiceAprendido *indice, int *capacidade, int chave, long long posicao, double inclinacao);
+
+
+//----------------------------------Funções definidas no .h----------------------------------
+IndiceAprendido* construir_indice_aprendido(BPlusTree *arvore, int erro_maximo) {
+    if (arvore == NULL || arvore->raiz == NULL) return NULL;
+    descarregar_buffers(arvore);
+
+    IndiceAprendido *indice = (IndiceAprendido*)calloc(1, sizeof(IndiceAprendido));
+    if (!indice) {
+        perror("Falha ao alocar memória para o índice aprendido");
+        exit(EXIT_FAILURE);
+    }
+    indice->arvore = arvore;
+    indice->erro_maximo = erro_maximo < 0 ? 0 : erro_maximo;
+
+    copiar_folhas(indice);
+    ajustar_segmentos(indice);
+    return indice;
+}
+
+
+Carro* buscar_aprendido(IndiceAprendido *indice, int chave) {
+    if (indice == NULL) return NULL;
+
+    // Último segmento que começa em chave <= `chave`.
+    int ini = 0, fim = indice->num_segmentos - 1;
+    if (chave < indice->segmentos[0].chave_inicial) return buscar(indice->arvore, chave);
+    while (ini < fim) {
+        int meio = (ini + fim + 1) / 2;
+        if (indice->segmentos[meio].chave_inicial <= chave) ini = meio;
+        else fim = meio - 1;
+    }
+    SegmentoLinear *seg = &indice->segmentos[ini];
+
+    // Posição prevista e janela de erro garantida pelo ajuste.
+    long long previsto = seg->posicao_inicial
+                       + (long long)(seg->inclinacao * ((long long)chave - seg->chave_inicial));
+    long long baixo = previsto - indice->erro_maximo - 1;
+    long long alto = previsto + indice->erro_maximo + 1;
+    if (baixo < 0) baixo = 0;
+    if (alto > indice->num_chaves) alto = indice->num_chaves;
+
+    // Primeira posição da janela com chave >= `chave`.
+    while (baixo < alto) {
+        long long meio = baixo + (alto - baixo) / 2;
+        if (indice->chaves[meio] < chave) baixo = meio + 1;
+        else alto = meio;
+    }
+    if (baixo < indice->num_chaves && indice->chaves[baixo] == chave) {
+        return indice->valores[baixo];
+    }
+
+    // Chave inexistente ou inserida depois da construção: recorre à árvore.
+    return buscar(indice->arvore, chave);
+}
+
+
+size_t memoria_indice_aprendido(IndiceAprendido *indice) {
+    if (indice == NULL) return 0;
+    return sizeof(IndiceAprendido)
+         + indice->num_chaves * (sizeof(int) + sizeof(Carro*))
+         + indice->num_segmentos * sizeof(SegmentoLinear);
+}
+
+
+void destruir_indice_aprendido(IndiceAprendido *indice) {
+    if (indice == NULL) return;
+    free(indice->chaves);
+    free(indice->valores);
+    free(indice->segmentos);
+    free(indice);
+}
+
+//----------------------------------Funções internas (implementações)----------------------------------
+void copiar_folhas(IndiceAprendido *indice) {
+    No *primeira = indice->arvore->raiz;
+    while (!primeira->folha) {
+        primeira = (No*)primeira->ponteiros[0];
+    }
+
+    long long total = 0;
+    for (No *folha = primeira; folha != NULL; folha = folha->prox_folha) {
+        total += folha->num_chaves;
+    }
+
+    indice->chaves = (int*)malloc(total * sizeof(int));
+    indice->valores = (Carro**)malloc(total * sizeof(Carro*));
+    if (!indice->chaves || !indice->valores) {
+        perror("Falha ao alocar memória para as entradas do índice aprendido");
+        exit(EXIT_FAILURE);
+    }
+
+    bool com_lista = indice->arvore->politica_duplicatas == DUPLICATAS_LISTA;
+    long long pos = 0;
+    for (No *folha = primeira; folha != NULL; folha = folha->prox_folha) {
+        for (int i = 0; i < folha->num_chaves; i++) {
+            indice->chaves[pos] = folha->chaves[i];
+            indice->valores[pos] = com_lista ? ((ListaCarros*)folha->ponteiros[i])->carros[0]
+                                             : (Carro*)folha->ponteiros[i];
+            pos++;
+        }
+    }
+    indice->num_chaves = total;
+}
+
+
+void ajustar_segmentos(IndiceAprendido *indice) {
+    int capacidade = 0;
+    double erro = indice->erro_maximo;
+
+    long long inicio = 0;
+    double inclinacao_min = 0, inclinacao_max = 1e300;
+    for (long long pos = 1; pos < indice->num_chaves; pos++) {
+        if (indice->chaves[pos] == indice->chaves[pos - 1]) continue; // Só a 1ª ocorrência conta.
+
+        double dx = (double)indice->chaves[pos] - indice->chaves[inicio];
+        double dy = (double)(pos - inicio);
+        double novo_min = (dy - erro) / dx;
+        double novo_max = (dy + erro) / dx;
+        if (novo_min < inclinacao_min) novo_min = inclinacao_min;
+        if (novo_max > inclinacao_max) novo_max = inclinacao_max;
+
+        if (novo_min > novo_max) {
+            // O cone fechou: encerra o segmento atual e começa outro nesta chave.
+            adicionar_segmento(indice, &capacidade, indice->chaves[inicio], inicio,
+                               (inclinacao_min + inclinacao_max) / 2);
+            inicio = pos;
+            inclinacao_min = 0;
+            inclinacao_max = 1e300;
+        } else {
+            inclinacao_min = novo_min;
+            inclinacao_max = novo_max;
+        }
+    }
+    // Um segmento com uma única chave não restringe a inclinação.
+    double inclinacao = (inclinacao_max == 1e300) ? 0 : (inclinacao_min + inclinacao_max) / 2;
+    adicionar_segmento(indice, &capacidade, indice->chaves[inicio], inicio, inclinacao);
+}
+
+
+void adicionar_segmento(IndiceAprendido *indice, int *capacidade, int chave, long long posicao, double inclinacao) {
+    if (indice->num_segmentos == *capacidade) {
+        int nova_capacidade = *capacidade ? *capacidade * 2 : 16;
+        SegmentoLinear *novos = (SegmentoLinear*)realloc(indice->segmentos, nova_capacidade * sizeof(SegmentoLinear));
+        if (!novos) {
+            perror("Falha ao expandir os segmentos do índice aprendido");
+            exit(EXIT_FAILURE);
+        }
+        indice->segmentos = novos;
+        *capacidade = nova_capacidade;
+    }
+    indice->segmentos[indice->num_segmentos].chave_inicial = chave;
+    indice->segmentos[indice->num_segmentos].posicao_inicial = posicao;
+    indice->segmentos[indice->num_segmentos].inclinacao = inclinacao;
+    indice->num_segmentos++;
+}
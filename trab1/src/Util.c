@@ -1,6 +1,8 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <time.h>
+#include <math.h>
+#include <unistd.h>
 #include "../include/Util.h"
 #include "../include/Carro.h"
 #include <sys/resource.h>
@@ -63,4 +65,191 @@ long get_block_size(const char *path) {
         return -1;
     }
     return buf.f_bsize; // tamanho do bloco em bytes
-}
\ No newline at end of file
+}
+
+
+/**
+ * @brief Lê um tamanho de cache em /sys (ex.: "32K"), para quando o sysconf não informa.
+ * @param caminho Arquivo em /sys/devices/system/cpu/cpu0/cache.
+ * @return O tamanho em bytes, ou -1 se não foi possível ler.
+ */
+static long ler_tamanho_sysfs(const char *caminho) {
+    FILE *f = fopen(caminho, "r");
+    if (!f) return -1;
+    long valor = -1;
+    char sufixo = 0;
+    int lidos = fscanf(f, "%ld%c", &valor, &sufixo);
+    fclose(f);
+    if (lidos < 1) return -1;
+    if (sufixo == 'K') valor *= 1024;
+    else if (sufixo == 'M') valor *= 1024 * 1024;
+    return valor;
+}
+
+
+/**
+ * @brief Retorna o primeiro valor positivo entre o sysconf, o sysfs e um padrão.
+ */
+static long escolher_medida(long via_sysconf, const char *caminho_sysfs, long padrao) {
+    if (via_sysconf > 0) return via_sysconf;
+    long via_sysfs = ler_tamanho_sysfs(caminho_sysfs);
+    return via_sysfs > 0 ? via_sysfs : padrao;
+}
+
+
+InfoHardware medir_hardware(const char *path) {
+    InfoHardware hw;
+    long via_sysconf;
+
+#ifdef _SC_LEVEL1_DCACHE_LINESIZE
+    via_sysconf = sysconf(_SC_LEVEL1_DCACHE_LINESIZE);
+#else
+    via_sysconf = -1;
+#endif
+    hw.linha_cache = escolher_medida(via_sysconf, "/sys/devices/system/cpu/cpu0/cache/index0/coherency_line_size", 64);
+
+#ifdef _SC_LEVEL1_DCACHE_SIZE
+    via_sysconf = sysconf(_SC_LEVEL1_DCACHE_SIZE);
+#else
+    via_sysconf = -1;
+#endif
+    hw.cache_l1 = escolher_medida(via_sysconf, "/sys/devices/system/cpu/cpu0/cache/index0/size", 32 * 1024);
+
+#ifdef _SC_LEVEL2_CACHE_SIZE
+    via_sysconf = sysconf(_SC_LEVEL2_CACHE_SIZE);
+#else
+    via_sysconf = -1;
+#endif
+    hw.cache_l2 = escolher_medida(via_sysconf, "/sys/devices/system/cpu/cpu0/cache/index2/size", 256 * 1024);
+
+    hw.bloco_disco = get_block_size(path);
+    if (hw.bloco_disco <= 0) hw.bloco_disco = 4096;
+    return hw;
+}
+
+
+/**
+ * @brief Maior ordem cujo nó (tamanho útil, ver `tamanho_no_bplustree`) cabe em `bytes`.
+ */
+static int ordem_que_cabe(long bytes) {
+    int ordem = 3;
+    while (ordem < MAX_ORDER && (long)tamanho_no_bplustree(NULL, ordem + 1) <= bytes) {
+        ordem++;
+    }
+    return ordem;
+}
+
+
+/**
+ * @brief Adiciona uma ordem à lista de candidatas, ignorando repetições.
+ */
+static void adicionar_candidato(int *candidatos, int *num_candidatos, int ordem) {
+    if (ordem < 3) ordem = 3;
+    if (ordem > MAX_ORDER) ordem = MAX_ORDER;
+    for (int i = 0; i < *num_candidatos; i++) {
+        if (candidatos[i] == ordem) return;
+    }
+    if (*num_candidatos < MAX_CANDIDATOS_ORDEM) candidatos[(*num_candidatos)++] = ordem;
+}
+
+
+/**
+ * @brief Tempo de relógio em milissegundos, para cronometrar a calibração.
+ */
+static double agora_ms(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1000.0 + ts.tv_nsec / 1e6;
+}
+
+
+AjusteOrdem ajustar_ordem_automaticamente(const Carro *carros, int num_registros, const InfoHardware *hw) {
+    AjusteOrdem ajuste = {0};
+    int candidatos[MAX_CANDIDATOS_ORDEM];
+    int num_candidatos = 0;
+
+    // Nós que ocupam 1, 2, 4, 8 e 16 linhas de cache, metade da L1 e exatamente um bloco de disco.
+    for (int linhas = 1; linhas <= 16; linhas *= 2) {
+        adicionar_candidato(candidatos, &num_candidatos, ordem_que_cabe(hw->linha_cache * linhas));
+    }
+    adicionar_candidato(candidatos, &num_candidatos, ordem_que_cabe(hw->cache_l1 / 2));
+    adicionar_candidato(candidatos, &num_candidatos, ordem_que_cabe(hw->bloco_disco));
+    // Mantém as ordens usadas no benchmark manual como referência.
+    int ordens_manuais[] = {5, 20, 50, 150, 220, 300, 400, 800};
+    for (int i = 0; i < (int)(sizeof(ordens_manuais) / sizeof(int)); i++) {
+        adicionar_candidato(candidatos, &num_candidatos, ordens_manuais[i]);
+    }
+
+    int n = num_registros < MAX_REGISTROS_CALIBRACAO ? num_registros : MAX_REGISTROS_CALIBRACAO;
+    if (n <= 0) {
+        ajuste.ordem_memoria = ajuste.ordem_disco = ordem_que_cabe(hw->bloco_disco);
+        snprintf(ajuste.justificativa, sizeof(ajuste.justificativa),
+                 "Sem registros para calibrar; usando a ordem que preenche um bloco de %ld bytes.", hw->bloco_disco);
+        return ajuste;
+    }
+
+    int *chaves = malloc(NUM_BUSCAS_CALIBRACAO * sizeof(int));
+    if (!chaves) {
+        perror("Falha ao alocar chaves de calibração");
+        exit(EXIT_FAILURE);
+    }
+    for (int i = 0; i < NUM_BUSCAS_CALIBRACAO; i++) {
+        chaves[i] = carros[rand() % n].renavam;
+    }
+
+    double melhor_tempo = -1, melhor_custo = -1, tempo_da_melhor_disco = 0;
+    double acessos_da_melhor_disco = 0;
+    for (int c = 0; c < num_candidatos; c++) {
+        int ordem = candidatos[c];
+        double menor_tempo = -1;
+        double acessos_por_busca = 0;
+
+        for (int r = 0; r < REPETICOES_CALIBRACAO; r++) {
+            BPlusTree *arvore = criar_arvore_bplus(ordem);
+            if (!arvore) break;
+
+            double inicio = agora_ms();
+            for (int k = 0; k < n; k++) {
+                inserir(arvore, carros[k].renavam, (Carro*)&carros[k]);
+            }
+            volatile int encontradas = 0;
+            for (int k = 0; k < NUM_BUSCAS_CALIBRACAO; k++) {
+                if (buscar(arvore, chaves[k]) != NULL) encontradas++;
+            }
+            double tempo = agora_ms() - inicio;
+
+            acessos_por_busca = (double)arvore->acessos_de_disco_simulados / NUM_BUSCAS_CALIBRACAO;
+            if (menor_tempo < 0 || tempo < menor_tempo) menor_tempo = tempo;
+            destruir_arvore(arvore);
+        }
+        if (menor_tempo < 0) continue;
+
+        double blocos_por_no = ceil((double)tamanho_no_bplustree(NULL, ordem) / (double)hw->bloco_disco);
+        double custo = acessos_por_busca * blocos_por_no;
+
+        if (melhor_tempo < 0 || menor_tempo < melhor_tempo) {
+            melhor_tempo = menor_tempo;
+            ajuste.ordem_memoria = ordem;
+        }
+        // No disco vale o custo simulado; o tempo medido só desempata.
+        if (melhor_custo < 0 || custo < melhor_custo || (custo == melhor_custo && menor_tempo < tempo_da_melhor_disco)) {
+            melhor_custo = custo;
+            tempo_da_melhor_disco = menor_tempo;
+            acessos_da_melhor_disco = acessos_por_busca;
+            ajuste.ordem_disco = ordem;
+        }
+    }
+    free(chaves);
+
+    ajuste.tempo_memoria_ms = melhor_tempo;
+    ajuste.custo_disco = melhor_custo;
+    snprintf(ajuste.justificativa, sizeof(ajuste.justificativa),
+             "%d ordens candidatas (linha de cache %ld B, L1 %ld B, L2 %ld B, bloco %ld B) calibradas com "
+             "%d inserções + %d buscas. Memória: ordem %d (nó de %zu B) teve o menor tempo, %.3f ms. "
+             "Disco: ordem %d (nó de %zu B, %.2f acessos por busca) teve o menor custo simulado, %.2f.",
+             num_candidatos, hw->linha_cache, hw->cache_l1, hw->cache_l2, hw->bloco_disco,
+             n, NUM_BUSCAS_CALIBRACAO,
+             ajuste.ordem_memoria, tamanho_no_bplustree(NULL, ajuste.ordem_memoria), melhor_tempo,
+             ajuste.ordem_disco, tamanho_no_bplustree(NULL, ajuste.ordem_disco), acessos_da_melhor_disco, melhor_custo);
+    return ajuste;
+}
@@ -7,6 +7,7 @@
 #include "../include/Carro.h"
 #include "../include/BPlusTree.h"
 #include "../include/Util.h"
+#include "../include/IndiceAprendido.h"
 #include <sys/resource.h>
 
 
@@ -15,7 +16,10 @@
 #define MAX_COR_LEN 30      // Tamanho máximo para a string da cor do carro.
 
 
-int main() {
+int main(int argc, char *argv[]) {
+    // Com "--auto", as ordens testadas são escolhidas por calibração em vez da lista fixa.
+    bool modo_auto = argc > 1 && strcmp(argv[1], "--auto") == 0;
+
     printf("Contando registros no arquivo...\n");
     long total_registros_no_arquivo = contar_registros("docs/registros.txt");
     if (total_registros_no_arquivo == 0) {
@@ -38,6 +42,19 @@ int main() {
     int ordens_para_testar[] = {5, 20 ,50, 150, 220, 300, 400, 800};
     int num_ordens = sizeof(ordens_para_testar) / sizeof(int);
 
+    if (modo_auto) {
+        printf("Medindo hardware e calibrando a ordem da árvore...\n");
+        InfoHardware hw = medir_hardware("docs/registros.txt");
+        AjusteOrdem ajuste = ajustar_ordem_automaticamente(todos_os_carros, total_carregado, &hw);
+        printf("Ordem escolhida para memória: %d\n", ajuste.ordem_memoria);
+        printf("Ordem escolhida para disco..: %d\n", ajuste.ordem_disco);
+        printf("Justificativa: %s\n", ajuste.justificativa);
+
+        ordens_para_testar[0] = ajuste.ordem_memoria;
+        ordens_para_testar[1] = ajuste.ordem_disco;
+        num_ordens = (ajuste.ordem_memoria == ajuste.ordem_disco) ? 1 : 2;
+    }
+
     int tamanhos_para_testar[] = {100, 1000, 10000, 100000, 1000000, 10000000, 20000000};
     int num_tamanhos = sizeof(tamanhos_para_testar) / sizeof(int);
 
@@ -69,6 +86,17 @@ int main() {
             }
             clock_t fim_insercao = clock();
 
+            // Mesma carga no modo com buffers (inclui a descarga final até as folhas)
+            BPlusTree* arvore_buffer = criar_arvore_bplus(ordem_atual);
+            definir_buffer_insercoes(arvore_buffer, true);
+            clock_t inicio_insercao_buffer = clock();
+            for (int k = 0; k < tamanho_atual; k++) {
+                inserir(arvore_buffer, todos_os_carros[k].renavam, &todos_os_carros[k]);
+            }
+            descarregar_buffers(arvore_buffer);
+            clock_t fim_insercao_buffer = clock();
+            destruir_arvore(arvore_buffer);
+
             // Fase de Busca (cronometrada e com contagem de acessos)
             clock_t inicio = clock();
             int buscas_encontradas = 0;
@@ -79,9 +107,23 @@ int main() {
             }
             clock_t fim = clock();
 
+            // Mesmas buscas pelo índice aprendido construído sobre as folhas
+            IndiceAprendido *indice = construir_indice_aprendido(arvore, ERRO_INDICE_APRENDIDO);
+            long long acessos_antes_indice = arvore->acessos_de_disco_simulados;
+            clock_t inicio_aprendido = clock();
+            int buscas_encontradas_aprendido = 0;
+            for (int k = 0; k < NUM_BUSCAS_A_REALIZAR; k++) {
+                if (buscar_aprendido(indice, chaves_para_busca[k]) != NULL) buscas_encontradas_aprendido++;
+            }
+            clock_t fim_aprendido = clock();
+            // Fallbacks para a árvore não entram na média de acessos da busca normal.
+            arvore->acessos_de_disco_simulados = acessos_antes_indice;
+            double tempo_aprendido_ms = ((double)(fim_aprendido - inicio_aprendido) * 1000.0) / CLOCKS_PER_SEC;
+
             double tempo_total_cpu = ((double)(fim - inicio)) / CLOCKS_PER_SEC;
             double tempo_medio_ms = (tempo_total_cpu * 1000.0) / (double)NUM_BUSCAS_A_REALIZAR;
             double tempo_insercao_ms = ((double)(fim_insercao - inicio_insercao) * 1000.0) / CLOCKS_PER_SEC;
+            double tempo_insercao_buffer_ms = ((double)(fim_insercao_buffer - inicio_insercao_buffer) * 1000.0) / CLOCKS_PER_SEC;
             size_t tamanho_no = tamanho_no_bplustree(arvore, ordem_atual);
             long tamanho_bloco = get_block_size("docs/registros.txt");
             
@@ -106,10 +148,41 @@ int main() {
             // Tempo de Execução
             printf("  \t[Tempo de Execução]\n");
             printf("    \t Tempo total de inserção..............: %.6f ms\n", tempo_insercao_ms);
+            printf("    \t Tempo total de inserção (com buffers): %.6f ms\n", tempo_insercao_buffer_ms);
             printf("    \t Tempo total de busca (CPU)...........: %.6f ms\n", tempo_total_cpu * 1000);
             printf("    \t Tempo médio por busca (em CPU).......: %.6f ms (%d/%d encontradas)\n",
                 tempo_medio_ms, buscas_encontradas, NUM_BUSCAS_A_REALIZAR);
 
+            // Forma e ocupação da árvore, para correlacionar com a latência das buscas
+            EstatisticasArvore est = estatisticas_arvore(arvore);
+            bool arvore_valida = verificar_arvore(arvore);
+            printf("  \t[Estrutura da Árvore]\n");
+            printf("    \t Altura...............................: %d níveis\n", est.altura);
+            printf("    \t Nós por nível........................:");
+            for (int n = 0; n < est.altura && n < MAX_NIVEIS; n++) {
+                printf(" %ld", est.nos_por_nivel[n]);
+            }
+            printf("\n");
+            printf("    \t Nós (internos/folhas)................: %ld (%ld/%ld)\n",
+                est.total_nos, est.nos_internos, est.folhas);
+            printf("    \t Ocupação média (folhas/internos).....: %.2f%% / %.2f%%\n",
+                est.ocupacao_media_folhas * 100.0, est.ocupacao_media_internos * 100.0);
+            printf("    \t Memória alocada / útil...............: %.2f KB / %.2f KB\n",
+                (double)est.bytes_totais / 1024, (double)est.bytes_uteis / 1024);
+            printf("    \t Desperdício por MAX_ORDER............: %.2f KB\n",
+                (double)est.bytes_desperdicados_max_order / 1024);
+            printf("    \t Slots de chave livres................: %ld\n", est.slots_livres);
+            printf("    \t Invariantes..........................: %s\n", arvore_valida ? "OK" : "VIOLADOS");
+
+            // Índice aprendido comparado à descida na árvore
+            printf("  \t[Índice Aprendido (erro máx. %d)]\n", ERRO_INDICE_APRENDIDO);
+            printf("    \t Segmentos lineares...................: %d\n", indice->num_segmentos);
+            printf("    \t Memória do índice....................: %.2f KB\n",
+                (double)memoria_indice_aprendido(indice) / 1024);
+            printf("    \t Tempo total de busca (CPU)...........: %.6f ms (%d/%d encontradas)\n",
+                tempo_aprendido_ms, buscas_encontradas_aprendido, NUM_BUSCAS_A_REALIZAR);
+            destruir_indice_aprendido(indice);
+
             // Custo Simulado de Acesso ao Disco
             printf("  \t[Simulação de Acesso a Disco]\n");
             printf("    \t Média de acessos por busca...........: %.2f\n", media_acessos_por_busca);